@@ -1,7 +1,6 @@
 #include <queue>
 #include <limits>
 #include <algorithm>
-#include <stack>
 #include "Algorithm.h"
 
 namespace Graph
@@ -24,90 +23,76 @@ namespace Graph
             return true;
         }
 
-        bool IsConnected(const LGraph& graph) noexcept   // 判断连通性
+        template <typename W,typename Dir>
+        bool IsConnected(const BasicLGraph<W,Dir>& graph) noexcept   // 判断连通性
         {
             size_t n=graph.VertexCount();
             if (!n){
                 return true;
             }
             DSU dsu (n);
-            for (Vertex u=0;u<n;u++){                       // 只处理 u<v 的边，避免重复
-                for (const Edge& e : graph.List()[u].adj){
-                    if (u<e.to){
+            std::vector <char> touched;                     // 有向图中只有入边的顶点出度为 0，需单独记录
+            if constexpr (Dir::directed){
+                touched.assign(n,0);
+            }
+            for (Vertex u=0;u<n;u++){                       // 无向图只处理 u<v 的边，避免重复
+                for (const BasicEdge<W>& e : graph.Adj(u)){
+                    if constexpr (Dir::directed){
+                        touched[u]=touched[e.to]=1;
+                        dsu.Union(u,e.to);
+                    }
+                    else if (u<e.to){
                         dsu.Union(u,e.to);
                     }
                 }
             }
             Vertex root=dsu.Find(0);
-            for (int i=0;i<n;i++){
-                if (graph.List()[i].adj.empty()||dsu.Find(i)!=root){
+            for (Vertex i=0;i<n;i++){
+                bool isolated=Dir::directed ? !touched[i] : !graph.Degree(i);
+                if (isolated||dsu.Find(i)!=root){
                     return false;
                 }
             }
             return true;
         }
 
-        bool ExistEulerCircuit(const LGraph& graph) noexcept    // 判断是否存在欧拉回路
+        template <typename W,typename Dir>
+        static std::vector<size_t> InDegrees(const BasicLGraph<W,Dir>& graph)      // 有向图各顶点的入度
         {
-            if (!IsConnected(graph)){
-                return false;
-            }
-            for (const VertexNode& v : graph.List()){
-                if (v.adj.size()%2){
-                    return false;
+            std::vector <size_t> indeg(graph.VertexCount(),0);
+            for (Vertex u=0;u<graph.VertexCount();u++){
+                for (const BasicEdge<W>& e : graph.Adj(u)){
+                    indeg[e.to]++;
                 }
             }
-            return true;
+            return indeg;
         }
 
-        std::list<Vertex> EulerCircuit(const LGraph& graph,Vertex start)     // 计算欧拉回路
+        template <typename W,typename Dir>
+        bool ExistEulerCircuit(const BasicLGraph<W,Dir>& graph) noexcept    // 判断是否存在欧拉回路
         {
-            if (!ExistEulerCircuit(graph)){
-                return {};
-            }
-            size_t n=graph.VertexCount();
-            if (!n){
-                return {};
-            }
-            if (start>=n){
-                throw GraphException("起始顶点ID越界");
+            if (!IsConnected(graph)){
+                return false;
             }
-            std::vector<std::vector<std::pair<Vertex,size_t>>> adj(n);
-            size_t edgeId=0;
-            for (Vertex u=0;u<n;u++){
-                for (const Edge& e : graph.List()[u].adj){
-                    if (u<e.to){
-                        adj[u].emplace_back(e.to,edgeId);
-                        adj[e.to].emplace_back(u,edgeId);
-                        edgeId++;
+            if constexpr (Dir::directed){
+                std::vector <size_t> indeg=InDegrees(graph);
+                for (Vertex u=0;u<graph.VertexCount();u++){
+                    if (graph.Degree(u)!=indeg[u]){
+                        return false;
                     }
                 }
+                return true;
             }
-            std::vector <bool> used(2*edgeId,false);
-            std::vector <size_t> idx(n,0);
-            std::stack <Vertex> stk;
-            std::list <Vertex> res;
-            stk.push(start);
-            while (!stk.empty()){
-                Vertex u=stk.top();
-                while (idx[u]<adj[u].size()&&used[2*adj[u][idx[u]].second+(adj[u][idx[u]].first<u)]){
-                    idx[u]++;
-                }
-                if (idx[u]==adj[u].size()){
-                    stk.pop();
-                    res.push_back(u);
-                }
-                else {
-                    auto [v,eid]=adj[u][idx[u]];
-                    used[2*eid]=used[2*eid+1]=true;
-                    stk.push(v);
+            for (Vertex u=0;u<graph.VertexCount();u++){
+                if (graph.Degree(u)%2){
+                    return false;
                 }
             }
-            res.reverse();
-            return res;
+            return true;
         }
 
-        int GetShortestPath(const LGraph& graph,const std::string& xName,const std::string& yName)  // 单源最短路径（Dijkstra）
+        template <typename W,typename Dir>
+        PathWeight<W> GetShortestPath(const BasicLGraph<W,Dir>& graph,const std::string& xName,const std::string& yName)  // 单源最短路径（Dijkstra）
         {
             const std::map <std::string,Vertex>& ver_map=graph.Map();
             auto itx=ver_map.find(xName);
@@ -118,14 +103,14 @@ namespace Graph
             Vertex xid=itx->second;
             Vertex yid=ity->second;
             int n=graph.VertexCount();
-            const std::vector <VertexNode>& ver_list=graph.List();
 
-            const long long INF=std::numeric_limits <long long>::max();
-            std::vector <long long> dist(n,INF);
+            using D=PathWeight<W>;
+            const D INF=std::numeric_limits <D>::max();
+            std::vector <D> dist(n,INF);
             dist[xid]=0;
 
             // 优先队列：<距离, 顶点>
-            std::priority_queue<std::pair<long long,Vertex>,std::vector<std::pair<long long,Vertex>>,std::greater<>> pq;
+            std::priority_queue<std::pair<D,Vertex>,std::vector<std::pair<D,Vertex>>,std::greater<>> pq;
             pq.push({0,xid});
 
             while (!pq.empty()){
@@ -138,9 +123,9 @@ namespace Graph
                     break;      // 提前退出
                 }
 
-                for (const Edge& e : ver_list[u].adj){
+                for (const BasicEdge<W>& e : graph.Adj(u)){
                     Vertex v=e.to;
-                    long long plus=d+e.weight;
+                    D plus=d+e.weight;
                     if (plus<dist[v]){
                         dist[v]=plus;
                         pq.push({plus,v});
@@ -151,7 +136,8 @@ namespace Graph
             return dist[yid]==INF ? -1 : dist[yid];
         }
 
-        int TopologicalShortestPath(const LGraph& graph,const std::vector<std::string>& path)   // 拓扑受限最短路径
+        template <typename W,typename Dir>
+        PathWeight<W> TopologicalShortestPath(const BasicLGraph<W,Dir>& graph,const std::vector<std::string>& path)   // 拓扑受限最短路径
         {
             if (path.empty()){
                 return 0;
@@ -161,10 +147,10 @@ namespace Graph
                     throw GraphException("路径中包含不存在的顶点: " + name);
                 }
             }
-            int res=0;
+            PathWeight<W> res=0;
             for (size_t i=0;i<path.size()-1;i++)
             {
-                int d=GetShortestPath(graph,path[i],path[i+1]);
+                PathWeight<W> d=GetShortestPath(graph,path[i],path[i+1]);
                 if (d<0){
                     return -1;
                 }
@@ -173,26 +159,27 @@ namespace Graph
             return res;
         }
 
-        std::vector<Edge> MinimumSpanningTree(const LGraph& graph)      // Kruskal 最小生成树
+        template <typename W>
+        std::vector<BasicEdge<W>> MinimumSpanningTree(const BasicLGraph<W,Undirected>& graph)      // Kruskal 最小生成树
         {
             size_t n=graph.VertexCount();
             if (n<2){
                 return {};
             }
             DSU dsu(n);
-            std::vector <Edge> edges;
+            std::vector <BasicEdge<W>> edges;
             edges.reserve(graph.EdgesCount());
             for (Vertex u=0;u<n;u++){                               // 只收集 u<v 的那半边
-                for (const Edge& e : graph.List()[u].adj){
+                for (const BasicEdge<W>& e : graph.Adj(u)){
                     if (u<e.to){
                         edges.push_back(e);
                     }
                 }
             }
-            std::sort(edges.begin(),edges.end(),[](const Edge& a,const Edge& b){ return a.weight<b.weight; });
-            std::vector <Edge> res;
+            std::sort(edges.begin(),edges.end(),[](const BasicEdge<W>& a,const BasicEdge<W>& b){ return a.weight<b.weight; });
+            std::vector <BasicEdge<W>> res;
             res.reserve(n-1);
-            for (const Edge& e : edges){
+            for (const BasicEdge<W>& e : edges){
                 if (dsu.Union(e.from,e.to)){
                     res.push_back(e);
                     if (res.size()==n-1){
@@ -200,10 +187,11 @@ namespace Graph
                     }
                 }
             }
-            return res.size()==n-1 ? res : std::vector<Edge>{};
+            return res.size()==n-1 ? res : std::vector<BasicEdge<W>>{};
         }
 
-        bool ExistEulerPath(const LGraph& graph)
+        template <typename W,typename Dir>
+        bool ExistEulerPath(const BasicLGraph<W,Dir>& graph)
         {
             Vertex n=graph.VertexCount();
             if (!n){
@@ -212,16 +200,34 @@ namespace Graph
             if (!IsConnected(graph)){
                 return false;
             }
+            if constexpr (Dir::directed){       // 至多一个出度多 1 的起点和一个入度多 1 的终点
+                std::vector <size_t> indeg=InDegrees(graph);
+                int starts=0,ends=0;
+                for (Vertex u=0;u<n;u++){
+                    size_t out=graph.Degree(u);
+                    if (out==indeg[u]+1){
+                        starts++;
+                    }
+                    else if (indeg[u]==out+1){
+                        ends++;
+                    }
+                    else if (out!=indeg[u]){
+                        return false;
+                    }
+                }
+                return starts==ends&&starts<=1;
+            }
             int odd=0;
-            for (const VertexNode& v : graph.List()){
-                if (v.adj.size()%2){
+            for (Vertex u=0;u<n;u++){
+                if (graph.Degree(u)%2){
                     odd++;
                 }
             }
             return odd==0||odd==2;
         }
 
-        std::pair<int, std::vector<std::string>> ShortestPathwithTrace(const LGraph& graph, const std::string& xName, const std::string& yName)
+        template <typename W,typename Dir>
+        std::pair<PathWeight<W>,std::vector<std::string>> ShortestPathwithTrace(const BasicLGraph<W,Dir>& graph,const std::string& xName,const std::string& yName)
         {
             if (!graph.ExistVertex(xName)||!graph.ExistVertex(yName)){
                 return {-1,{}};
@@ -229,12 +235,12 @@ namespace Graph
             const std::map<std::string,Vertex>& map=graph.Map();
             Vertex xid=map.at(xName),yid=map.at(yName);
             int n=graph.VertexCount();
-            const std::vector<VertexNode>& list=graph.List();
-            const long long INF=std::numeric_limits<long long>::max();
-            std::vector <long long> dist(n,INF);
+            using D=PathWeight<W>;
+            const D INF=std::numeric_limits<D>::max();
+            std::vector <D> dist(n,INF);
             std::vector <int> prev(n,-1);
             dist[xid]=0;
-            std::priority_queue<std::pair<long long,size_t>,std::vector<std::pair<long long,size_t>>,std::greater<std::pair<long long,size_t>>> pq;
+            std::priority_queue<std::pair<D,size_t>,std::vector<std::pair<D,size_t>>,std::greater<std::pair<D,size_t>>> pq;
             pq.push({0,xid});
             while (!pq.empty()){
                 auto [d,u]=pq.top();
@@ -245,9 +251,9 @@ namespace Graph
                 if (u==yid){
                     break;
                 }
-                for (const Edge& e : list[u].adj){
+                for (const BasicEdge<W>& e : graph.Adj(u)){
                     Vertex v=e.to;
-                    long long nd=d+e.weight;
+                    D nd=d+e.weight;
                     if (nd<dist[v]){
                         dist[v]=nd;
                         prev[v]=u;
@@ -260,10 +266,58 @@ namespace Graph
             }
             std::vector <std::string> path;
             for (size_t to=yid;to!=-1;to=prev[to]){
-                path.push_back(graph.GetVertex(to).name);
+                path.push_back(graph.Name(to));
             }
             std::reverse(path.begin(),path.end());
-            return {(int)dist[yid],path};
+            return {dist[yid],path};
         }
+
+        template <typename W,typename Dir>
+        PathTree<W> ShortestPathTree(const BasicLGraph<W,Dir>& graph,const std::string& sourceName)    // 单源最短路径树（Dijkstra）
+        {
+            auto it=graph.Map().find(sourceName);
+            if (it==graph.Map().end()){
+                throw GraphException("顶点不存在");
+            }
+            using D=PathWeight<W>;
+            size_t n=graph.VertexCount();
+            PathTree<W> tree;
+            tree.dist.assign(n,PathTree<W>::Unreachable);
+            tree.parent.assign(n,PathTree<W>::NoParent);
+            tree.dist[it->second]=0;
+            std::priority_queue<std::pair<D,Vertex>,std::vector<std::pair<D,Vertex>>,std::greater<>> pq;
+            pq.push({0,it->second});
+            while (!pq.empty()){
+                auto [d,u]=pq.top();
+                pq.pop();
+                if (d>tree.dist[u]){
+                    continue;
+                }
+                for (const BasicEdge<W>& e : graph.Adj(u)){
+                    D nd=d+e.weight;
+                    if (nd<tree.dist[e.to]){
+                        tree.dist[e.to]=nd;
+                        tree.parent[e.to]=u;
+                        pq.push({nd,e.to});
+                    }
+                }
+            }
+            return tree;
+        }
+
+        #define INSTANTIATE_ALGORITHM(W,Dir) \
+            template bool IsConnected(const BasicLGraph<W,Dir>&) noexcept; \
+            template bool ExistEulerCircuit(const BasicLGraph<W,Dir>&) noexcept; \
+            template PathWeight<W> GetShortestPath(const BasicLGraph<W,Dir>&,const std::string&,const std::string&); \
+            template PathWeight<W> TopologicalShortestPath(const BasicLGraph<W,Dir>&,const std::vector<std::string>&); \
+            template bool ExistEulerPath(const BasicLGraph<W,Dir>&); \
+            template PathTree<W> ShortestPathTree(const BasicLGraph<W,Dir>&,const std::string&); \
+            template std::pair<PathWeight<W>,std::vector<std::string>> ShortestPathwithTrace(const BasicLGraph<W,Dir>&,const std::string&,const std::string&);
+        GRAPH_FOR_EACH_INSTANCE(INSTANTIATE_ALGORITHM)
+        #undef INSTANTIATE_ALGORITHM
+
+        #define INSTANTIATE_MST(W) template std::vector<BasicEdge<W>> MinimumSpanningTree(const BasicLGraph<W,Undirected>&);
+        GRAPH_FOR_EACH_WEIGHT(INSTANTIATE_MST)
+        #undef INSTANTIATE_MST
     }
 }
\ No newline at end of file
@@ -1,9 +1,9 @@
 #ifndef CAMPUSNAVIGATION_ALGORITHM_H
 #define CAMPUSNAVIGATION_ALGORITHM_H
 
-#include <list>
 #include <string>
 #include <vector>
+#include <limits>
 #include <functional>
 #include "LGraph/LGraph.h"
 #include "GraphException.h"
@@ -27,28 +27,74 @@ namespace Graph
                 bool Union (Vertex x,Vertex y) noexcept;
         };
 
-        // 判断图是否连通
-        bool IsConnected(const LGraph& graph) noexcept;
+        template <typename W>
+        struct PathTree     // 单源最短路径树
+        {
+            static constexpr PathWeight<W> Unreachable=std::numeric_limits<PathWeight<W>>::max();
+            static constexpr Vertex NoParent=static_cast<Vertex>(-1);
+            std::vector <PathWeight<W>> dist;   // 源点到各顶点的距离，不可达为 Unreachable
+            std::vector <Vertex> parent;        // 最短路径上的前驱，源点与不可达顶点为 NoParent
+        };
+
+        // 判断图是否连通（有向图按弱连通判断）
+        template <typename W,typename Dir>
+        bool IsConnected(const BasicLGraph<W,Dir>& graph) noexcept;
 
-        // 判断是否存在欧拉回路（所有顶点度为偶数且连通）
-        bool ExistEulerCircuit(const LGraph& graph) noexcept;
+        // 判断是否存在欧拉回路（无向图所有顶点度为偶数，有向图所有顶点入度等于出度，且连通）
+        template <typename W,typename Dir>
+        bool ExistEulerCircuit(const BasicLGraph<W,Dir>& graph) noexcept;
 
-        // 计算欧拉回路，返回顶点访问顺序列表，若不存在则返回空列表
-        std::list<Vertex> EulerCircuit(const LGraph& graph,Vertex start);
+        // 计算从 start 出发的欧拉回路，返回顶点访问顺序（首尾均为 start），若不存在则返回空
+        template <typename W,typename Dir>
+        std::vector<Vertex> EulerCircuit(const BasicLGraph<W,Dir>& graph,Vertex start);
 
         // 单源最短路径，返回顶点 x 到 y 的最短距离，不可达返回 -1（使用 Dijkstra 算法）
-        int GetShortestPath(const LGraph& graph,const std::string& xName,const std::string& yName);
+        template <typename W,typename Dir>
+        PathWeight<W> GetShortestPath(const BasicLGraph<W,Dir>& graph,const std::string& xName,const std::string& yName);
 
         // 拓扑受限最短路径，输入一系列顶点名称，依序计算前后两点的最短路径并累加
-        int TopologicalShortestPath(const LGraph& graph,const std::vector<std::string>& path);
+        template <typename W,typename Dir>
+        PathWeight<W> TopologicalShortestPath(const BasicLGraph<W,Dir>& graph,const std::vector<std::string>& path);
+
+        // Kruskal 算法计算最小生成树，返回组成 MST 的边列表，无则返回空（仅无向图）
+        template <typename W>
+        std::vector<BasicEdge<W>> MinimumSpanningTree(const BasicLGraph<W,Undirected>& graph);
+
+        template <typename W,typename Dir>
+        bool ExistEulerPath(const BasicLGraph<W,Dir>& graph);
 
-        // Kruskal 算法计算最小生成树，返回组成 MST 的边列表，无则返回空
-        std::vector<Edge> MinimumSpanningTree(const LGraph& graph);
+        // 单源到所有顶点的最短路径树（Dijkstra）
+        template <typename W,typename Dir>
+        PathTree<W> ShortestPathTree(const BasicLGraph<W,Dir>& graph,const std::string& sourceName);
+
+        // 多线程 delta-stepping 计算单源到所有顶点的最短路径树，距离与 ShortestPathTree 完全一致。
+        // delta 为桶宽（<=0 时按最大边权与平均度自动选取），threads 为线程数（0 表示硬件线程数）
+        template <typename W,typename Dir>
+        PathTree<W> DeltaSteppingTree(const BasicLGraph<W,Dir>& graph,const std::string& sourceName,PathWeight<W> delta=0,unsigned threads=0);
+
+        template <typename W,typename Dir>
+        std::pair<PathWeight<W>,std::vector<std::string>> ShortestPathwithTrace(const BasicLGraph<W,Dir>& graph,const std::string& xName,const std::string& yName);
+
+        template <typename W>
+        struct PatrolRoute      // 巡逻路线
+        {
+            PathWeight<W> length=-1;        // 总长度，有边与起点不连通时为 -1
+            std::vector <Vertex> route;     // 顶点序列，首尾均为起点
+            bool optimal=true;              // 是否保证最短
+        };
 
-        bool ExistEulerPath(const LGraph& graph);
+        // 中国邮递员问题（巡逻路线）：从 start 出发、每条边至少走一次并回到 start 的闭合路线（仅无向图）。
+        // 奇度顶点按两两最短路距离做最小权完美匹配，匹配路径上的边重复一次后求欧拉回路。奇度顶点不超过 ExactMatchingLimit 个时
+        // 用带花树精确求匹配，路线最短；超过时 O(t^3) 太慢，改用贪心加局部交换的近似匹配，结果中 optimal 为 false
+        constexpr size_t ExactMatchingLimit=1000;
+        template <typename W>
+        PatrolRoute<W> ChinesePostmanRoute(const BasicLGraph<W,Undirected>& graph,Vertex start);
 
-        std::pair<int,std::vector<std::string>> ShortestPathwithTrace(const LGraph& graph,const std::string& xName,const std::string& yName);
+        // 前 k 条无环最短路径（Yen 算法），按长度升序返回 <长度, 顶点名称序列>，第一条即 ShortestPathwithTrace 的结果，
+        // 顶点不存在或不可达时返回空
+        template <typename W,typename Dir>
+        std::vector<std::pair<PathWeight<W>,std::vector<std::string>>> KShortestPaths(const BasicLGraph<W,Dir>& graph,const std::string& xName,const std::string& yName,size_t k);
     }
 }
 
-#endif // CAMPUSNAVIGATION_ALGORITHM_H
\ No newline at end of file
+#endif // CAMPUSNAVIGATION_ALGORITHM_H
@@ -0,0 +1,704 @@
+#include <cmath>
+#include <algorithm>
+#include "Algorithm.h"
+#include "CsrSnapshot.h"
+
+namespace Graph
+{
+    namespace Algorithm
+    {
+        namespace
+        {
+            using Arc=std::pair<uint32_t,uint32_t>;
+
+            // Hierholzer 算法：edges 为多重图的边表（无向图每条边只列一次，允许重边）。
+            // 先按端点计数把边排成连续的 offset/arc 数组，再用显式栈一遍走完，O(V+E) 时间且分配次数与图的大小无关。
+            // 返回从 start 出发的闭合回路，调用方需保证各顶点度数满足条件；与 start 不连通的边不会出现在结果中
+            std::vector<Vertex> EulerTour(size_t n,const std::vector<Arc>& edges,bool directed,Vertex start)
+            {
+                std::vector <size_t> offset(n+1,0);
+                for (auto [u,v] : edges){
+                    offset[u+1]++;
+                    if (!directed){
+                        offset[v+1]++;
+                    }
+                }
+                for (size_t u=0;u<n;u++){
+                    offset[u+1]+=offset[u];
+                }
+                std::vector <uint32_t> arcTo(offset[n]);
+                std::vector <uint32_t> arcEdge(directed ? 0 : offset[n]);  // 无向图两个方向的弧共用一个边编号
+                std::vector <size_t> cursor(offset.begin(),offset.end()-1);
+                for (uint32_t id=0;id<edges.size();id++){
+                    auto [u,v]=edges[id];
+                    if (!directed){
+                        arcEdge[cursor[u]]=id;
+                    }
+                    arcTo[cursor[u]++]=v;
+                    if (!directed){
+                        arcEdge[cursor[v]]=id;
+                        arcTo[cursor[v]++]=u;
+                    }
+                }
+                std::copy(offset.begin(),offset.end()-1,cursor.begin());   // 改作各顶点下一条待检查的弧
+                std::vector <char> used(arcEdge.empty() ? 0 : edges.size(),0);  // 有向图每条弧只会被扫到一次，不需要标记
+
+                std::vector <uint32_t> stack;
+                std::vector <Vertex> tour;
+                stack.reserve(edges.size()+1);
+                tour.reserve(edges.size()+1);
+                stack.push_back(start);
+                while (!stack.empty()){
+                    uint32_t u=stack.back();
+                    size_t& k=cursor[u];
+                    if (!directed){
+                        while (k<offset[u+1]&&used[arcEdge[k]]){
+                            k++;
+                        }
+                    }
+                    if (k==offset[u+1]){
+                        tour.push_back(u);
+                        stack.pop_back();
+                    }
+                    else {
+                        if (!directed){
+                            used[arcEdge[k]]=1;
+                        }
+                        stack.push_back(arcTo[k++]);
+                    }
+                }
+                std::reverse(tour.begin(),tour.end());
+                return tour;
+            }
+
+            // 在快照上反复做单源 Dijkstra，距离与前驱数组按版本号复用，每次搜索不必重新分配或清零
+            template <typename W>
+            class DistanceSearch
+            {
+                public:
+                    using D=PathWeight<W>;
+
+                private:
+                    const CsrSnapshot<W>& csr;
+                    std::vector <D> dist;
+                    std::vector <uint32_t> parent;
+                    std::vector <uint32_t> seen;    // dist/parent 的有效版本
+                    std::vector <std::pair<D,uint32_t>> heap;
+                    uint32_t epoch=0;
+
+                public:
+                    explicit DistanceSearch(const CsrSnapshot<W>& g) :
+                        csr(g),dist(g.VertexCount()),parent(g.VertexCount()),seen(g.VertexCount(),0) {}
+
+                    // 从 source 出发按距离递增确定顶点，每确定一个顶点调用 settle(v,d)，其返回 false 时提前结束
+                    template <typename F>
+                    void Run(uint32_t source,F&& settle)
+                    {
+                        epoch++;
+                        heap.clear();
+                        dist[source]=0;
+                        parent[source]=source;
+                        seen[source]=epoch;
+                        heap.push_back({0,source});
+                        while (!heap.empty()){
+                            std::pop_heap(heap.begin(),heap.end(),std::greater<>());
+                            auto [d,u]=heap.back();
+                            heap.pop_back();
+                            if (d>dist[u]){
+                                continue;
+                            }
+                            if (!settle(u,d)){
+                                return;
+                            }
+                            for (size_t k=csr.offset[u];k<csr.offset[u+1];k++){
+                                uint32_t v=csr.to[k];
+                                D nd=d+csr.weight[k];
+                                if (seen[v]!=epoch||nd<dist[v]){
+                                    seen[v]=epoch;
+                                    dist[v]=nd;
+                                    parent[v]=u;
+                                    heap.push_back({nd,v});
+                                    std::push_heap(heap.begin(),heap.end(),std::greater<>());
+                                }
+                            }
+                        }
+                    }
+
+                    uint32_t Parent(uint32_t v) const noexcept { return parent[v]; }
+            };
+
+            // 带权带花树（Edmonds 算法的 O(t^3) 实现）求完全图上的最大权匹配。边权全为正时最大权匹配一定是完美匹配。
+            // 顶点从 1 编号：1..t 为原顶点，t+1..2t 为收缩出的花，0 表示无
+            class Blossom
+            {
+                private:
+                    struct Edge             // 代表边，记录它在原顶点之间的端点；u 为 0 表示没有边
+                    {
+                        uint32_t u=0,v=0;
+                    };
+
+                    size_t n,nx,stride;
+                    std::vector <long long> weight;     // 原顶点之间的边权，(n+1)*(n+1)
+                    std::vector <Edge> g;               // 顶点或花之间的代表边，stride*stride
+                    std::vector <long long> lab;        // 对偶变量
+                    std::vector <uint32_t> match,slack,st,pa,vis,flowerFrom;   // st 为所在的最外层花，flowerFrom[b][x] 为花 b 中含原顶点 x 的直接子花
+                    std::vector <int> S;                // -1 未访问，0 外点，1 内点
+                    std::vector <std::vector<uint32_t>> flower;     // 花中按环的顺序排列的子花，第一个为花根
+                    std::vector <uint32_t> queue;
+                    size_t head=0;
+                    uint32_t stamp=0;
+
+                    Edge& G(size_t x,size_t y) { return g[x*stride+y]; }
+                    uint32_t& From(size_t b,size_t x) { return flowerFrom[b*(n+1)+x]; }
+                    long long Delta(const Edge& e) const { return lab[e.u]+lab[e.v]-weight[e.u*(n+1)+e.v]*2; }
+
+                    void UpdateSlack(uint32_t u,uint32_t x)
+                    {
+                        if (!slack[x]||Delta(G(u,x))<Delta(G(slack[x],x))){
+                            slack[x]=u;
+                        }
+                    }
+                    void SetSlack(uint32_t x)
+                    {
+                        slack[x]=0;
+                        for (uint32_t u=1;u<=n;u++){
+                            if (G(u,x).u&&st[u]!=x&&S[st[u]]==0){
+                                UpdateSlack(u,x);
+                            }
+                        }
+                    }
+                    void Push(uint32_t x)
+                    {
+                        if (x<=n){
+                            queue.push_back(x);
+                            return;
+                        }
+                        for (uint32_t y : flower[x]){
+                            Push(y);
+                        }
+                    }
+                    void SetSt(uint32_t x,uint32_t b)
+                    {
+                        st[x]=b;
+                        if (x>n){
+                            for (uint32_t y : flower[x]){
+                                SetSt(y,b);
+                            }
+                        }
+                    }
+                    size_t EvenPosition(uint32_t b,uint32_t xr)     // xr 在花环中的位置，必要时翻转环使从花根到 xr 的路径长为偶数
+                    {
+                        size_t pr=std::find(flower[b].begin(),flower[b].end(),xr)-flower[b].begin();
+                        if (pr%2){
+                            std::reverse(flower[b].begin()+1,flower[b].end());
+                            return flower[b].size()-pr;
+                        }
+                        return pr;
+                    }
+                    void SetMatch(uint32_t u,uint32_t v)
+                    {
+                        Edge e=G(u,v);
+                        match[u]=e.v;
+                        if (u>n){
+                            uint32_t xr=From(u,e.u);
+                            size_t pr=EvenPosition(u,xr);
+                            for (size_t i=0;i<pr;i++){
+                                SetMatch(flower[u][i],flower[u][i^1]);
+                            }
+                            SetMatch(xr,v);
+                            std::rotate(flower[u].begin(),flower[u].begin()+pr,flower[u].end());
+                        }
+                    }
+                    void Augment(uint32_t u,uint32_t v)
+                    {
+                        for (;;){
+                            uint32_t xnv=st[match[u]];
+                            SetMatch(u,v);
+                            if (!xnv){
+                                return;
+                            }
+                            SetMatch(xnv,st[pa[xnv]]);
+                            u=st[pa[xnv]];
+                            v=xnv;
+                        }
+                    }
+                    uint32_t Lca(uint32_t u,uint32_t v)
+                    {
+                        for (stamp++;u||v;std::swap(u,v)){
+                            if (!u){
+                                continue;
+                            }
+                            if (vis[u]==stamp){
+                                return u;
+                            }
+                            vis[u]=stamp;
+                            u=st[match[u]];
+                            if (u){
+                                u=st[pa[u]];
+                            }
+                        }
+                        return 0;
+                    }
+                    void AddBlossom(uint32_t u,uint32_t lca,uint32_t v)
+                    {
+                        uint32_t b=n+1;
+                        while (b<=nx&&st[b]){
+                            b++;
+                        }
+                        if (b>nx){
+                            nx++;
+                        }
+                        lab[b]=0;
+                        S[b]=0;
+                        match[b]=match[lca];
+                        flower[b].assign(1,lca);
+                        for (uint32_t x=u,y;x!=lca;x=st[pa[y]]){
+                            flower[b].push_back(x);
+                            flower[b].push_back(y=st[match[x]]);
+                            Push(y);
+                        }
+                        std::reverse(flower[b].begin()+1,flower[b].end());
+                        for (uint32_t x=v,y;x!=lca;x=st[pa[y]]){
+                            flower[b].push_back(x);
+                            flower[b].push_back(y=st[match[x]]);
+                            Push(y);
+                        }
+                        SetSt(b,b);
+                        for (uint32_t x=1;x<=nx;x++){
+                            G(b,x)=G(x,b)=Edge();
+                        }
+                        for (uint32_t x=1;x<=n;x++){
+                            From(b,x)=0;
+                        }
+                        for (uint32_t xs : flower[b]){      // 花到每个顶点的代表边取各子花中松弛量最小的一条
+                            for (uint32_t x=1;x<=nx;x++){
+                                if (G(xs,x).u&&(!G(b,x).u||Delta(G(xs,x))<Delta(G(b,x)))){
+                                    G(b,x)=G(xs,x);
+                                    G(x,b)=G(x,xs);
+                                }
+                            }
+                            for (uint32_t x=1;x<=n;x++){
+                                if (From(xs,x)){
+                                    From(b,x)=xs;
+                                }
+                            }
+                        }
+                        SetSlack(b);
+                    }
+                    void ExpandBlossom(uint32_t b)      // 展开对偶变量降为 0 的内点花
+                    {
+                        for (uint32_t x : flower[b]){
+                            SetSt(x,x);
+                        }
+                        uint32_t xr=From(b,G(b,pa[b]).u);
+                        size_t pr=EvenPosition(b,xr);
+                        for (size_t i=0;i<pr;i+=2){
+                            uint32_t xs=flower[b][i],xns=flower[b][i+1];
+                            pa[xs]=G(xns,xs).u;
+                            S[xs]=1;
+                            S[xns]=0;
+                            slack[xs]=0;
+                            SetSlack(xns);
+                            Push(xns);
+                        }
+                        S[xr]=1;
+                        pa[xr]=pa[b];
+                        for (size_t i=pr+1;i<flower[b].size();i++){
+                            S[flower[b][i]]=-1;
+                            SetSlack(flower[b][i]);
+                        }
+                        st[b]=0;
+                    }
+                    bool FoundEdge(const Edge& e)       // 处理一条紧边，找到增广路并增广后返回 true
+                    {
+                        uint32_t u=st[e.u],v=st[e.v];
+                        if (S[v]==-1){
+                            pa[v]=e.u;
+                            S[v]=1;
+                            uint32_t nu=st[match[v]];
+                            slack[v]=slack[nu]=0;
+                            S[nu]=0;
+                            Push(nu);
+                        }
+                        else if (S[v]==0){
+                            uint32_t lca=Lca(u,v);
+                            if (!lca){
+                                Augment(u,v);
+                                Augment(v,u);
+                                return true;
+                            }
+                            AddBlossom(u,lca,v);
+                        }
+                        return false;
+                    }
+                    bool Phase()        // 从所有未匹配顶点出发找一条增广路，找不到时返回 false
+                    {
+                        std::fill(S.begin()+1,S.begin()+nx+1,-1);
+                        std::fill(slack.begin()+1,slack.begin()+nx+1,0);
+                        queue.clear();
+                        head=0;
+                        for (uint32_t x=1;x<=nx;x++){
+                            if (st[x]==x&&!match[x]){
+                                pa[x]=0;
+                                S[x]=0;
+                                Push(x);
+                            }
+                        }
+                        if (queue.empty()){
+                            return false;
+                        }
+                        for (;;){
+                            while (head<queue.size()){
+                                uint32_t u=queue[head++];
+                                if (S[st[u]]==1){
+                                    continue;
+                                }
+                                for (uint32_t v=1;v<=n;v++){
+                                    if (G(u,v).u&&st[u]!=st[v]){
+                                        if (Delta(G(u,v))==0){
+                                            if (FoundEdge(G(u,v))){
+                                                return true;
+                                            }
+                                        }
+                                        else {
+                                            UpdateSlack(u,st[v]);
+                                        }
+                                    }
+                                }
+                            }
+                            // 没有紧边可用时调整对偶变量
+                            long long d=std::numeric_limits<long long>::max();
+                            for (uint32_t b=n+1;b<=nx;b++){
+                                if (st[b]==b&&S[b]==1){
+                                    d=std::min(d,lab[b]/2);
+                                }
+                            }
+                            for (uint32_t x=1;x<=nx;x++){
+                                if (st[x]==x&&slack[x]){
+                                    if (S[x]==-1){
+                                        d=std::min(d,Delta(G(slack[x],x)));
+                                    }
+                                    else if (S[x]==0){
+                                        d=std::min(d,Delta(G(slack[x],x))/2);
+                                    }
+                                }
+                            }
+                            for (uint32_t u=1;u<=n;u++){
+                                if (S[st[u]]==0){
+                                    if (lab[u]<=d){
+                                        return false;
+                                    }
+                                    lab[u]-=d;
+                                }
+                                else if (S[st[u]]==1){
+                                    lab[u]+=d;
+                                }
+                            }
+                            for (uint32_t b=n+1;b<=nx;b++){
+                                if (st[b]==b){
+                                    if (S[b]==0){
+                                        lab[b]+=d*2;
+                                    }
+                                    else if (S[b]==1){
+                                        lab[b]-=d*2;
+                                    }
+                                }
+                            }
+                            queue.clear();
+                            head=0;
+                            for (uint32_t x=1;x<=nx;x++){
+                                if (st[x]==x&&slack[x]&&st[slack[x]]!=x&&Delta(G(slack[x],x))==0){
+                                    if (FoundEdge(G(slack[x],x))){
+                                        return true;
+                                    }
+                                }
+                            }
+                            for (uint32_t b=n+1;b<=nx;b++){
+                                if (st[b]==b&&S[b]==1&&lab[b]==0){
+                                    ExpandBlossom(b);
+                                }
+                            }
+                        }
+                    }
+
+                public:
+                    // w 为 t*t 的正边权矩阵（对角线忽略），返回每个顶点的配对对象（从 0 编号）
+                    explicit Blossom(size_t t,const std::vector<long long>& w) :
+                        n(t),nx(t),stride(2*t+1),weight((t+1)*(t+1),0),g(stride*stride),lab(stride,0),
+                        match(stride,0),slack(stride,0),st(stride,0),pa(stride,0),vis(stride,0),flowerFrom(stride*(t+1),0),
+                        S(stride,-1),flower(stride)
+                    {
+                        long long maxWeight=0;
+                        for (uint32_t u=1;u<=n;u++){
+                            st[u]=u;
+                            From(u,u)=u;
+                            for (uint32_t v=1;v<=n;v++){
+                                if (u!=v){
+                                    weight[u*(n+1)+v]=w[(u-1)*n+v-1];
+                                    G(u,v)={u,v};
+                                    maxWeight=std::max(maxWeight,weight[u*(n+1)+v]);
+                                }
+                            }
+                        }
+                        std::fill(lab.begin()+1,lab.begin()+n+1,maxWeight);
+                    }
+
+                    std::vector<uint32_t> Solve()
+                    {
+                        while (Phase()){
+                        }
+                        std::vector <uint32_t> mate(n);
+                        for (uint32_t u=1;u<=n;u++){
+                            mate[u-1]=match[u]-1;
+                        }
+                        return mate;
+                    }
+            };
+
+            // 最小权完美匹配：求出奇度顶点两两之间的最短路距离，边权取 (最大距离 + 1 - 距离) 后做最大权匹配，
+            // 完美匹配的边数固定，所以总权最大即总距离最小。浮点边权先按最大距离缩放到 2^40 再取整，误差远小于边权精度。
+            // 返回每个顶点的配对对象，无法完美匹配（有顶点互不可达）时返回空
+            template <typename W>
+            std::vector<uint32_t> ExactMatching(const std::vector<uint32_t>& odd,DistanceSearch<W>& search,const std::vector<uint32_t>& oddIndex)
+            {
+                using D=PathWeight<W>;
+                constexpr D INF=PathTree<W>::Unreachable;
+                size_t t=odd.size();
+                std::vector <D> dist(t*t,INF);
+                D maxDist=0;
+                for (size_t i=0;i<t;i++){
+                    size_t found=0;
+                    search.Run(odd[i],[&](uint32_t v,D d){
+                        if (oddIndex[v]!=EdgeArena<W>::NoVertex){
+                            dist[i*t+oddIndex[v]]=d;
+                            maxDist=std::max(maxDist,d);
+                            return ++found<t;
+                        }
+                        return true;
+                    });
+                    if (found<t){
+                        return {};
+                    }
+                }
+                double scale=maxDist>0 ? std::ldexp(1.0,40)/maxDist : 1;
+                auto Quantize=[&](D d)->long long{
+                    if constexpr (std::is_floating_point_v<D>){
+                        return std::llround(d*scale);
+                    }
+                    else {
+                        return d;
+                    }
+                };
+                std::vector <long long> w(t*t);
+                long long base=Quantize(maxDist)+1;
+                for (size_t k=0;k<t*t;k++){
+                    w[k]=base-Quantize(dist[k]);
+                }
+                return Blossom(t,w).Solve();
+            }
+
+            // 奇度顶点很多时的近似匹配：每个顶点只算到最近的 Near 个奇度顶点的距离作为候选，
+            // 先按距离贪心配对，剩下的顶点各自搜索最近的未配对顶点，最后对两对之间的交换做局部改进
+            template <typename W>
+            std::vector<uint32_t> GreedyMatching(const std::vector<uint32_t>& odd,DistanceSearch<W>& search,const std::vector<uint32_t>& oddIndex)
+            {
+                using D=PathWeight<W>;
+                constexpr size_t Near=8;
+                constexpr int MaxPasses=16;
+                constexpr uint32_t None=EdgeArena<W>::NoVertex;
+                size_t t=odd.size();
+                std::vector <std::pair<uint32_t,D>> near(t*Near,{None,0});  // 每个顶点的候选：<奇度顶点下标, 距离>
+                std::vector <std::tuple<D,uint32_t,uint32_t>> candidates;
+                candidates.reserve(t*Near);
+                for (uint32_t i=0;i<t;i++){
+                    size_t found=0;
+                    search.Run(odd[i],[&](uint32_t v,D d){
+                        uint32_t j=oddIndex[v];
+                        if (j!=None&&j!=i){
+                            near[i*Near+found]={j,d};
+                            candidates.emplace_back(d,i,j);
+                            return ++found<Near;
+                        }
+                        return true;
+                    });
+                }
+                auto Known=[&](uint32_t a,uint32_t b,D& d){     // 查询候选中记录过的 a、b 间距离
+                    for (size_t k=0;k<Near;k++){
+                        if (near[a*Near+k].first==b){
+                            d=near[a*Near+k].second;
+                            return true;
+                        }
+                        if (near[b*Near+k].first==a){
+                            d=near[b*Near+k].second;
+                            return true;
+                        }
+                    }
+                    return false;
+                };
+
+                std::vector <uint32_t> mate(t,None);
+                std::vector <D> mateDist(t,0);
+                std::sort(candidates.begin(),candidates.end());
+                for (auto [d,i,j] : candidates){
+                    if (mate[i]==None&&mate[j]==None){
+                        mate[i]=j;
+                        mate[j]=i;
+                        mateDist[i]=mateDist[j]=d;
+                    }
+                }
+                for (uint32_t i=0;i<t;i++){
+                    if (mate[i]!=None){
+                        continue;
+                    }
+                    search.Run(odd[i],[&](uint32_t v,D d){
+                        uint32_t j=oddIndex[v];
+                        if (j!=None&&j!=i&&mate[j]==None){
+                            mate[i]=j;
+                            mate[j]=i;
+                            mateDist[i]=mateDist[j]=d;
+                            return false;
+                        }
+                        return true;
+                    });
+                    if (mate[i]==None){
+                        return {};
+                    }
+                }
+
+                // 局部改进：配对 (a,b)、(c,e) 若改成 (a,c)、(b,e) 更短则交换，只使用已知的候选距离
+                for (int pass=0;pass<MaxPasses;pass++){
+                    bool improved=false;
+                    for (uint32_t a=0;a<t;a++){
+                        for (size_t k=0;k<Near;k++){
+                            auto [c,dac]=near[a*Near+k];
+                            uint32_t b=mate[a];
+                            if (c==None||c==b){
+                                continue;
+                            }
+                            uint32_t e=mate[c];
+                            D dbe;
+                            if (!Known(b,e,dbe)||dac+dbe>=mateDist[a]+mateDist[c]){
+                                continue;
+                            }
+                            mate[a]=c;
+                            mate[c]=a;
+                            mate[b]=e;
+                            mate[e]=b;
+                            mateDist[a]=mateDist[c]=dac;
+                            mateDist[b]=mateDist[e]=dbe;
+                            improved=true;
+                        }
+                    }
+                    if (!improved){
+                        break;
+                    }
+                }
+                return mate;
+            }
+        }
+
+        template <typename W,typename Dir>
+        std::vector<Vertex> EulerCircuit(const BasicLGraph<W,Dir>& graph,Vertex start)     // 计算欧拉回路
+        {
+            if (!ExistEulerCircuit(graph)){
+                return {};
+            }
+            size_t n=graph.VertexCount();
+            if (!n){
+                return {};
+            }
+            if (start>=n){
+                throw GraphException("起始顶点ID越界");
+            }
+            std::vector <Arc> edges;
+            edges.reserve(graph.EdgesCount());
+            for (Vertex u=0;u<n;u++){
+                size_t loops=0;
+                for (const BasicEdge<W>& e : graph.Adj(u)){
+                    // 无向图每条边只列一次，自环在邻接表中出现两次，隔一次取一次
+                    if (Dir::directed||u<e.to||(u==e.to&&loops++%2==0)){
+                        edges.emplace_back(u,e.to);
+                    }
+                }
+            }
+            return EulerTour(n,edges,Dir::directed,start);
+        }
+
+        template <typename W>
+        PatrolRoute<W> ChinesePostmanRoute(const BasicLGraph<W,Undirected>& graph,Vertex start)    // 中国邮递员巡逻路线
+        {
+            using D=PathWeight<W>;
+            PatrolRoute<W> res;
+            size_t n=graph.VertexCount();
+            if (start>=n){
+                throw GraphException("起始顶点ID越界");
+            }
+            const CsrSnapshot<W> csr=MakeSnapshot(graph);
+            std::vector <Arc> edges;
+            edges.reserve(graph.EdgesCount());
+            std::vector <uint32_t> odd;
+            std::vector <uint32_t> oddIndex(n,EdgeArena<W>::NoVertex);
+            D total=0;
+            for (uint32_t u=0;u<n;u++){
+                if (csr.Degree(u)%2){
+                    oddIndex[u]=odd.size();
+                    odd.push_back(u);
+                }
+                size_t loops=0;
+                for (size_t k=csr.offset[u];k<csr.offset[u+1];k++){
+                    if (u<csr.to[k]||(u==csr.to[k]&&loops++%2==0)){     // 自环同样只列一次
+                        edges.emplace_back(u,csr.to[k]);
+                        total+=csr.weight[k];
+                    }
+                }
+            }
+            if (edges.empty()){
+                res.length=0;
+                res.route={start};
+                return res;
+            }
+
+            // 把奇度顶点两两配对，每对之间最短路径上的边各重复一次，所有顶点即变为偶度
+            DistanceSearch<W> search(csr);
+            std::vector <uint32_t> mate;
+            if (!odd.empty()){
+                res.optimal=odd.size()<=ExactMatchingLimit;
+                mate=res.optimal ? ExactMatching(odd,search,oddIndex) : GreedyMatching(odd,search,oddIndex);
+                if (mate.empty()){
+                    return res;
+                }
+            }
+            for (uint32_t i=0;i<mate.size();i++){
+                if (i>mate[i]){
+                    continue;
+                }
+                uint32_t target=odd[mate[i]];
+                search.Run(odd[i],[&](uint32_t v,D d){
+                    if (v==target){
+                        total+=d;
+                        return false;
+                    }
+                    return true;
+                });
+                for (uint32_t v=target;v!=odd[i];v=search.Parent(v)){
+                    edges.emplace_back(search.Parent(v),v);
+                }
+            }
+
+            std::vector <Vertex> route=EulerTour(n,edges,false,start);
+            if (route.size()==edges.size()+1){      // 否则有边与 start 不连通
+                res.length=total;
+                res.route=std::move(route);
+            }
+            return res;
+        }
+
+        #define INSTANTIATE_EULER_CIRCUIT(W,Dir) template std::vector<Vertex> EulerCircuit(const BasicLGraph<W,Dir>&,Vertex);
+        GRAPH_FOR_EACH_INSTANCE(INSTANTIATE_EULER_CIRCUIT)
+        #undef INSTANTIATE_EULER_CIRCUIT
+
+        #define INSTANTIATE_CHINESE_POSTMAN(W) template PatrolRoute<W> ChinesePostmanRoute(const BasicLGraph<W,Undirected>&,Vertex);
+        GRAPH_FOR_EACH_WEIGHT(INSTANTIATE_CHINESE_POSTMAN)
+        #undef INSTANTIATE_CHINESE_POSTMAN
+    }
+}
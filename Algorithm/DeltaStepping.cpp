@@ -0,0 +1,231 @@
+#include <atomic>
+#include <barrier>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <algorithm>
+#include "Algorithm.h"
+#include "CsrSnapshot.h"
+
+namespace Graph
+{
+    namespace Algorithm
+    {
+        namespace
+        {
+            constexpr size_t ChunkSize=64;      // 每个工作块包含的前沿顶点数
+
+            class WorkQueue     // 每个线程一个：线程从自己的队头取块，空闲时从其他线程的队尾窃取
+            {
+                private:
+                    std::mutex mtx;
+                    std::deque<std::pair<size_t,size_t>> chunks;
+                public:
+                    void Push(size_t begin,size_t end)
+                    {
+                        std::lock_guard<std::mutex> lock(mtx);
+                        chunks.emplace_back(begin,end);
+                    }
+                    bool Pop(std::pair<size_t,size_t>& chunk)
+                    {
+                        std::lock_guard<std::mutex> lock(mtx);
+                        if (chunks.empty()){
+                            return false;
+                        }
+                        chunk=chunks.front();
+                        chunks.pop_front();
+                        return true;
+                    }
+                    bool Steal(std::pair<size_t,size_t>& chunk)
+                    {
+                        std::lock_guard<std::mutex> lock(mtx);
+                        if (chunks.empty()){
+                            return false;
+                        }
+                        chunk=chunks.back();
+                        chunks.pop_back();
+                        return true;
+                    }
+            };
+        }
+
+        template <typename W,typename Dir>
+        PathTree<W> DeltaSteppingTree(const BasicLGraph<W,Dir>& graph,const std::string& sourceName,PathWeight<W> delta,unsigned threads)
+        {
+            auto it=graph.Map().find(sourceName);
+            if (it==graph.Map().end()){
+                throw GraphException("顶点不存在");
+            }
+            using D=PathWeight<W>;
+            const D INF=PathTree<W>::Unreachable;
+            const Vertex source=it->second;
+            const CsrSnapshot<W> csr=MakeSnapshot(graph);
+            const size_t n=csr.VertexCount();
+
+            W maxWeight=0;
+            for (W w : csr.weight){
+                if (w<0){
+                    throw GraphException("delta-stepping 不支持负权边");
+                }
+                maxWeight=std::max(maxWeight,w);
+            }
+            if (delta<=0){      // 默认桶宽：最大边权 / 平均度
+                double avgDegree=n ? static_cast<double>(csr.to.size())/n : 1.0;
+                delta=static_cast<D>(maxWeight/std::max(1.0,avgDegree));
+                if (delta<=0){
+                    delta=1;
+                }
+            }
+            if (!threads){
+                threads=std::max(1u,std::thread::hardware_concurrency());
+            }
+            auto BucketOf=[delta](D d){ return static_cast<size_t>(d/delta); };
+
+            std::vector <std::atomic<D>> dist(n);
+            for (std::atomic<D>& d : dist){
+                d.store(INF,std::memory_order_relaxed);
+            }
+            dist[source].store(0,std::memory_order_relaxed);
+
+            std::map <size_t,std::vector<uint32_t>> buckets;                 // 非空桶，键为桶号
+            std::vector <std::vector<std::pair<size_t,uint32_t>>> outbox(threads);  // 各线程本轮新入桶的 <桶号, 顶点>
+            std::vector <WorkQueue> queues(threads);
+            std::vector <uint32_t> frontier;    // 本轮要松弛的顶点
+            std::vector <uint32_t> settled;     // 当前桶中已做过轻边松弛的顶点，待松弛重边
+            std::vector <size_t> stamp(n,0);    // 去重标记
+            size_t epoch=0;
+            size_t cur=0;
+            bool heavy=false;   // 本轮松弛重边（w>delta）还是轻边
+            bool done=false;
+            buckets[0].push_back(source);
+
+            // 串行阶段：合并各线程的入桶请求，选出下一轮前沿并切块分给各线程
+            auto Prepare=[&]() noexcept {
+                for (std::vector<std::pair<size_t,uint32_t>>& box : outbox){
+                    for (auto [b,v] : box){
+                        buckets[b].push_back(v);
+                    }
+                    box.clear();
+                }
+                if (!heavy){
+                    settled.insert(settled.end(),frontier.begin(),frontier.end());
+                }
+                frontier.clear();
+                heavy=false;
+                while (frontier.empty()){
+                    auto bit=buckets.find(cur);
+                    if (bit!=buckets.end()){        // 当前桶仍有顶点：继续轻边松弛
+                        std::vector <uint32_t> items=std::move(bit->second);
+                        buckets.erase(bit);
+                        epoch++;
+                        for (uint32_t v : items){   // 跳过重复项和已移到其他桶的过期项
+                            if (stamp[v]!=epoch&&BucketOf(dist[v].load(std::memory_order_relaxed))==cur){
+                                stamp[v]=epoch;
+                                frontier.push_back(v);
+                            }
+                        }
+                    }
+                    else if (!settled.empty()){     // 当前桶距离已确定：统一松弛一次重边
+                        epoch++;
+                        for (uint32_t v : settled){
+                            if (stamp[v]!=epoch){
+                                stamp[v]=epoch;
+                                frontier.push_back(v);
+                            }
+                        }
+                        settled.clear();
+                        heavy=true;
+                    }
+                    else if (!buckets.empty()){
+                        cur=buckets.begin()->first;
+                    }
+                    else {
+                        done=true;
+                        return;
+                    }
+                }
+                for (size_t b=0,t=0;b<frontier.size();b+=ChunkSize,t=(t+1)%threads){
+                    queues[t].Push(b,std::min(b+ChunkSize,frontier.size()));
+                }
+            };
+            Prepare();
+
+            std::barrier sync(threads,Prepare);
+            auto Work=[&](unsigned id){
+                std::vector <std::pair<size_t,uint32_t>>& box=outbox[id];
+                auto Next=[&](std::pair<size_t,size_t>& chunk){
+                    if (queues[id].Pop(chunk)){
+                        return true;
+                    }
+                    for (unsigned k=1;k<threads;k++){
+                        if (queues[(id+k)%threads].Steal(chunk)){
+                            return true;
+                        }
+                    }
+                    return false;
+                };
+                while (!done){
+                    std::pair<size_t,size_t> chunk;
+                    while (Next(chunk)){
+                        for (size_t i=chunk.first;i<chunk.second;i++){
+                            uint32_t u=frontier[i];
+                            D du=dist[u].load(std::memory_order_relaxed);
+                            for (size_t k=csr.offset[u];k<csr.offset[u+1];k++){
+                                if ((csr.weight[k]>delta)!=heavy){
+                                    continue;
+                                }
+                                uint32_t v=csr.to[k];
+                                D nd=du+csr.weight[k];
+                                D old=dist[v].load(std::memory_order_relaxed);
+                                while (nd<old){
+                                    if (dist[v].compare_exchange_weak(old,nd,std::memory_order_relaxed)){
+                                        box.emplace_back(BucketOf(nd),v);
+                                        break;
+                                    }
+                                }
+                            }
+                        }
+                    }
+                    sync.arrive_and_wait();
+                }
+            };
+            std::vector <std::thread> workers;
+            for (unsigned id=1;id<threads;id++){
+                workers.emplace_back(Work,id);
+            }
+            Work(0);
+            for (std::thread& t : workers){
+                t.join();
+            }
+
+            // 距离确定后沿紧边（dist[u]+w==dist[v]）从源点广度优先建树，零权边也不会成环
+            PathTree<W> tree;
+            tree.dist.resize(n);
+            for (size_t v=0;v<n;v++){
+                tree.dist[v]=dist[v].load(std::memory_order_relaxed);
+            }
+            tree.parent.assign(n,PathTree<W>::NoParent);
+            std::vector <char> seen(n,0);
+            std::vector <Vertex> order{source};
+            seen[source]=1;
+            for (size_t h=0;h<order.size();h++){
+                Vertex u=order[h];
+                for (size_t k=csr.offset[u];k<csr.offset[u+1];k++){
+                    Vertex v=csr.to[k];
+                    if (!seen[v]&&tree.dist[u]+csr.weight[k]==tree.dist[v]){
+                        seen[v]=1;
+                        tree.parent[v]=u;
+                        order.push_back(v);
+                    }
+                }
+            }
+            return tree;
+        }
+
+        #define INSTANTIATE_DELTA_STEPPING(W,Dir) \
+            template PathTree<W> DeltaSteppingTree(const BasicLGraph<W,Dir>&,const std::string&,PathWeight<W>,unsigned);
+        GRAPH_FOR_EACH_INSTANCE(INSTANTIATE_DELTA_STEPPING)
+        #undef INSTANTIATE_DELTA_STEPPING
+    }
+}
@@ -0,0 +1,221 @@
+#include <queue>
+#include <algorithm>
+#include "FacilityIndex.h"
+#include "CsrSnapshot.h"
+
+namespace Graph
+{
+    namespace Algorithm
+    {
+        template <typename W,typename Dir>
+        typename FacilityIndex<W,Dir>::Partition& FacilityIndex<W,Dir>::Fresh(TypeId type)
+        {
+            auto [it,inserted]=parts.try_emplace(type);
+            if (inserted||it->second.revision!=graph.Revision()){
+                Build(type,it->second);
+            }
+            return it->second;
+        }
+
+        template <typename W,typename Dir>
+        template <typename Arcs>
+        void FacilityIndex<W,Dir>::Propagate(Partition& part,std::vector<Entry>& heap,Arcs&& arcs)
+        {
+            std::make_heap(heap.begin(),heap.end(),std::greater<>());
+            while (!heap.empty()){
+                std::pop_heap(heap.begin(),heap.end(),std::greater<>());
+                auto [d,s,u]=heap.back();
+                heap.pop_back();
+                if (d!=part.dist[u]||s!=part.site[u]){
+                    continue;
+                }
+                arcs(u,[&](Vertex v,W w){
+                    D nd=d+w;
+                    if (std::tie(nd,s)<std::tie(part.dist[v],part.site[v])){
+                        part.dist[v]=nd;
+                        part.site[v]=s;
+                        part.parent[v]=u;
+                        heap.emplace_back(nd,s,v);
+                        std::push_heap(heap.begin(),heap.end(),std::greater<>());
+                    }
+                });
+            }
+        }
+
+        template <typename W,typename Dir>
+        void FacilityIndex<W,Dir>::Build(TypeId type,Partition& part)
+        {
+            size_t n=graph.VertexCount();
+            part.revision=graph.Revision();
+            part.dist.assign(n,Unreachable);
+            part.site.assign(n,NoSite);
+            part.parent.assign(n,NoSite);
+            std::vector <Entry> heap;
+            for (Vertex u=0;u<n;u++){
+                if (graph.Type(u)==type){
+                    part.dist[u]=0;
+                    part.site[u]=u;
+                    heap.emplace_back(0,u,u);
+                }
+            }
+            if constexpr (Dir::directed){       // 有向图求的是顶点到地点的距离，沿反向边从地点出发
+                const CsrSnapshot<W> rcsr=MakeSnapshot(graph,true);
+                Propagate(part,heap,[&](Vertex u,auto&& relax){
+                    for (size_t k=rcsr.offset[u];k<rcsr.offset[u+1];k++){
+                        relax(rcsr.to[k],rcsr.weight[k]);
+                    }
+                });
+            }
+            else {
+                Propagate(part,heap,[&](Vertex u,auto&& relax){
+                    for (const BasicEdge<W>& e : graph.Adj(u)){
+                        relax(e.to,e.weight);
+                    }
+                });
+            }
+        }
+
+        template <typename W,typename Dir>
+        void FacilityIndex<W,Dir>::Repair(Partition& part,TypeId type,Vertex a,Vertex b)
+        {
+            std::vector <Entry> heap;
+            // 边变长或被删时，只有经过它的最短路径受影响：若它是最短路树上的边，
+            // 则树中它下方的整棵子树失效，子树各顶点先从子树外的邻居取得候选值
+            Vertex child=part.parent[b]==a ? b : part.parent[a]==b ? a : NoSite;
+            if (child!=NoSite){
+                std::vector <Vertex> subtree{child};
+                for (size_t i=0;i<subtree.size();i++){
+                    for (const BasicEdge<W>& e : graph.Adj(subtree[i])){
+                        if (part.parent[e.to]==subtree[i]){
+                            subtree.push_back(e.to);
+                        }
+                    }
+                }
+                for (Vertex x : subtree){       // 地点本身可能因零权边归到了 ID 更小的地点名下，重置时仍以自身为候选
+                    bool isSite=graph.Type(x)==type;
+                    part.dist[x]=isSite ? 0 : Unreachable;
+                    part.site[x]=isSite ? x : NoSite;
+                    part.parent[x]=NoSite;
+                }
+                for (Vertex x : subtree){
+                    for (const BasicEdge<W>& e : graph.Adj(x)){
+                        if (part.site[e.to]==NoSite){
+                            continue;
+                        }
+                        D nd=part.dist[e.to]+e.weight;
+                        if (std::tie(nd,part.site[e.to])<std::tie(part.dist[x],part.site[x])){
+                            part.dist[x]=nd;
+                            part.site[x]=part.site[e.to];
+                            part.parent[x]=e.to;
+                        }
+                    }
+                    if (part.site[x]!=NoSite){
+                        heap.emplace_back(part.dist[x],part.site[x],x);
+                    }
+                }
+            }
+            // 边变短或新插入时，从两端各尝试经过它改进另一端
+            for (const BasicEdge<W>& e : graph.Adj(a)){
+                if (e.to!=b){
+                    continue;
+                }
+                for (auto [x,y] : {std::pair<Vertex,Vertex>(a,b),std::pair<Vertex,Vertex>(b,a)}){
+                    if (part.site[x]==NoSite){
+                        continue;
+                    }
+                    D nd=part.dist[x]+e.weight;
+                    if (std::tie(nd,part.site[x])<std::tie(part.dist[y],part.site[y])){
+                        part.dist[y]=nd;
+                        part.site[y]=part.site[x];
+                        part.parent[y]=x;
+                        heap.emplace_back(nd,part.site[y],y);
+                    }
+                }
+            }
+            Propagate(part,heap,[&](Vertex u,auto&& relax){
+                for (const BasicEdge<W>& e : graph.Adj(u)){
+                    relax(e.to,e.weight);
+                }
+            });
+        }
+
+        template <typename W,typename Dir>
+        void FacilityIndex<W,Dir>::EdgeChanged(Vertex u,Vertex v)
+        {
+            for (auto& [type,part] : parts){
+                bool inSync=part.revision+1==graph.Revision()&&part.dist.size()==graph.VertexCount();
+                if (Dir::directed||!inSync||u>=graph.VertexCount()||v>=graph.VertexCount()){
+                    continue;       // 保持过期，下次查询时重建
+                }
+                Repair(part,type,u,v);
+                part.revision=graph.Revision();
+            }
+        }
+
+        template <typename W,typename Dir>
+        std::pair<Vertex,typename FacilityIndex<W,Dir>::D> FacilityIndex<W,Dir>::Nearest(Vertex u,TypeId type)
+        {
+            if (u>=graph.VertexCount()){
+                throw GraphException("顶点ID越界: "+std::to_string(u));
+            }
+            const Partition& part=Fresh(type);
+            return {part.site[u],part.dist[u]};
+        }
+
+        template <typename W,typename Dir>
+        std::vector<std::pair<Vertex,typename FacilityIndex<W,Dir>::D>> FacilityIndex<W,Dir>::KNearest(Vertex u,TypeId type,size_t k)
+        {
+            std::vector <std::pair<Vertex,D>> res;
+            if (!k){
+                return res;
+            }
+            if (k==1){
+                auto nearest=Nearest(u,type);
+                if (nearest.first!=NoSite){
+                    res.push_back(nearest);
+                }
+                return res;
+            }
+            size_t n=graph.VertexCount();
+            if (u>=n){
+                throw GraphException("顶点ID越界: "+std::to_string(u));
+            }
+            if (scratchSeen.size()!=n){
+                scratchDist.assign(n,0);
+                scratchSeen.assign(n,0);
+                epoch=0;
+            }
+            epoch++;
+            std::priority_queue<std::pair<D,Vertex>,std::vector<std::pair<D,Vertex>>,std::greater<>> pq;
+            scratchDist[u]=0;
+            scratchSeen[u]=epoch;
+            pq.push({0,u});
+            while (!pq.empty()&&res.size()<k){      // 找到 k 处即停止
+                auto [d,x]=pq.top();
+                pq.pop();
+                if (d>scratchDist[x]){
+                    continue;
+                }
+                if (graph.Type(x)==type){
+                    res.emplace_back(x,d);
+                }
+                for (const BasicEdge<W>& e : graph.Adj(x)){
+                    D nd=d+e.weight;
+                    if (scratchSeen[e.to]!=epoch||nd<scratchDist[e.to]){
+                        scratchSeen[e.to]=epoch;
+                        scratchDist[e.to]=nd;
+                        pq.push({nd,e.to});
+                    }
+                }
+            }
+            std::sort(res.begin(),res.end(),[](const std::pair<Vertex,D>& a,const std::pair<Vertex,D>& b){
+                return std::tie(a.second,a.first)<std::tie(b.second,b.first);
+            });
+            return res;
+        }
+
+        #define INSTANTIATE_FACILITY_INDEX(W,Dir) template class FacilityIndex<W,Dir>;
+        GRAPH_FOR_EACH_INSTANCE(INSTANTIATE_FACILITY_INDEX)
+        #undef INSTANTIATE_FACILITY_INDEX
+    }
+}
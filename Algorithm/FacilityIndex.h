@@ -0,0 +1,62 @@
+#ifndef CAMPUSNAVIGATION_FACILITYINDEX_H
+#define CAMPUSNAVIGATION_FACILITYINDEX_H
+
+#include <map>
+#include <tuple>
+#include <vector>
+#include "Algorithm.h"
+
+namespace Graph
+{
+    namespace Algorithm
+    {
+        // 最近设施索引：对每种地点类型做一次多源 Dijkstra，把所有顶点划分到离它最近的该类地点名下（Voronoi 划分），
+        // 记录每个顶点的最近地点、距离与通往它的下一跳。距离相同时取顶点 ID 较小的地点，因此划分结果唯一。
+        // 划分在第一次查询某类型时建立，并记下图的修改版本号；无向图的单条边修改可通过 EdgeChanged 就地修正，
+        // 其他修改（顶点增删、批量提交、有向图的边修改）使划分过期，下次查询时重建
+        template <typename W,typename Dir>
+        class FacilityIndex
+        {
+            public:
+                using D=PathWeight<W>;
+                static constexpr D Unreachable=PathTree<W>::Unreachable;
+                static constexpr Vertex NoSite=PathTree<W>::NoParent;
+
+            private:
+                struct Partition
+                {
+                    uint64_t revision=0;            // 与之一致的图版本号
+                    std::vector <D> dist;           // 到最近同类地点的距离，不可达为 Unreachable
+                    std::vector <Vertex> site;      // 最近的同类地点，不可达为 NoSite
+                    std::vector <Vertex> parent;    // 通往最近地点的下一跳，地点本身与不可达顶点为 NoSite
+                };
+                using Entry=std::tuple<D,Vertex,Vertex>;    // <距离, 地点, 顶点>
+
+                const BasicLGraph<W,Dir>& graph;
+                std::map <TypeId,Partition> parts;
+                std::vector <D> scratchDist;        // KNearest 的距离数组，按版本号复用
+                std::vector <uint32_t> scratchSeen;
+                uint32_t epoch=0;
+
+                Partition& Fresh(TypeId type);                  // 取得与当前图一致的划分，过期时重建
+                void Build(TypeId type,Partition& part);        // 多源 Dijkstra 重建整个划分
+                void Repair(Partition& part,TypeId type,Vertex a,Vertex b);     // 无向边 a-b 修改后就地修正
+                template <typename Arcs>
+                void Propagate(Partition& part,std::vector<Entry>& heap,Arcs&& arcs);   // 从堆中的顶点继续 Dijkstra
+
+            public:
+                explicit FacilityIndex(const BasicLGraph<W,Dir>& g) : graph(g) {}
+
+                // 从 u 出发最近的 type 类地点，返回 <地点, 距离>，没有可达地点时地点为 NoSite
+                std::pair<Vertex,D> Nearest(Vertex u,TypeId type);
+                // 从 u 出发最近的 k 处 type 类地点，按 <距离, 地点 ID> 升序；k 为 1 时查划分，
+                // 否则从 u 做 Dijkstra，找到 k 处即停止
+                std::vector<std::pair<Vertex,D>> KNearest(Vertex u,TypeId type,size_t k);
+
+                void EdgeChanged(Vertex u,Vertex v);    // 边 u-v 被插入、删除或修改权重后调用（图的修改版本号应恰好加一）
+                void Clear() noexcept { parts.clear(); }
+        };
+    }
+}
+
+#endif // CAMPUSNAVIGATION_FACILITYINDEX_H
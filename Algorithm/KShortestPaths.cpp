@@ -0,0 +1,235 @@
+#include <queue>
+#include <set>
+#include <tuple>
+#include <algorithm>
+#include "Algorithm.h"
+#include "CsrSnapshot.h"
+
+namespace Graph
+{
+    namespace Algorithm
+    {
+        namespace
+        {
+            template <typename W>
+            PathWeight<W> ArcWeight(const CsrSnapshot<W>& csr,uint32_t u,uint32_t v)   // 快照中边 u -> v 的权重
+            {
+                for (size_t k=csr.offset[u];k<csr.offset[u+1];k++){
+                    if (csr.to[k]==v){
+                        return csr.weight[k];
+                    }
+                }
+                throw GraphException("路径中的边不存在");
+            }
+
+            template <typename W>
+            PathWeight<W> PathCost(const CsrSnapshot<W>& csr,const std::vector<uint32_t>& path)     // 按路径顺序累加边权
+            {
+                PathWeight<W> cost=0;
+                for (size_t i=0;i+1<path.size();i++){
+                    cost+=ArcWeight(csr,path[i],path[i+1]);
+                }
+                return cost;
+            }
+
+            // 各次偏离（spur）搜索共享的状态：
+            // 到终点的反向最短路树只算一次，既直接提供未受影响的偏离路径，也作为 A* 的启发函数；
+            // 搜索用的标记数组按版本号复用，每次偏离搜索不必重新分配或清零
+            template <typename W>
+            class SpurSearch
+            {
+                public:
+                    using D=PathWeight<W>;
+                    static constexpr D INF=PathTree<W>::Unreachable;
+                    static constexpr uint32_t None=static_cast<uint32_t>(-1);
+
+                private:
+                    const CsrSnapshot<W>& csr;
+                    uint32_t target;
+                    std::vector <D> h;              // 不删点删边时各顶点到终点的距离，是可采纳的下界
+                    std::vector <uint32_t> next;    // 反向最短路树中通往终点的下一跳
+                    std::vector <D> g;
+                    std::vector <uint32_t> from;
+                    std::vector <uint32_t> seen;    // g/from 的有效版本
+                    std::vector <uint32_t> blocked; // 根路径上禁止经过的顶点
+                    uint32_t epoch=0,blockEpoch=0;
+
+                    bool Removed(const std::vector<uint32_t>& removed,uint32_t v) const
+                    {
+                        return std::find(removed.begin(),removed.end(),v)!=removed.end();
+                    }
+
+                public:
+                    SpurSearch(const CsrSnapshot<W>& forward,const CsrSnapshot<W>& backward,uint32_t t) :
+                        csr(forward),target(t),h(forward.VertexCount(),INF),next(forward.VertexCount(),None),
+                        g(forward.VertexCount()),from(forward.VertexCount()),seen(forward.VertexCount(),0),blocked(forward.VertexCount(),0)
+                    {
+                        std::priority_queue<std::pair<D,uint32_t>,std::vector<std::pair<D,uint32_t>>,std::greater<>> pq;
+                        h[target]=0;
+                        pq.push({0,target});
+                        while (!pq.empty()){
+                            auto [d,u]=pq.top();
+                            pq.pop();
+                            if (d>h[u]){
+                                continue;
+                            }
+                            for (size_t k=backward.offset[u];k<backward.offset[u+1];k++){
+                                uint32_t v=backward.to[k];
+                                D nd=d+backward.weight[k];
+                                if (nd<h[v]){
+                                    h[v]=nd;
+                                    next[v]=u;
+                                    pq.push({nd,v});
+                                }
+                            }
+                        }
+                    }
+
+                    void Block(const std::vector<uint32_t>& path,size_t count)     // 禁止经过 path 的前 count 个顶点
+                    {
+                        blockEpoch++;
+                        for (size_t i=0;i<count;i++){
+                            blocked[path[i]]=blockEpoch;
+                        }
+                    }
+
+                    // 从 spur 到终点的最短路径，避开被禁止的顶点和 spur 出发的 removed 边，结果含两端
+                    bool Search(uint32_t spur,const std::vector<uint32_t>& removed,std::vector<uint32_t>& out)
+                    {
+                        out.clear();
+                        if (h[spur]==INF){
+                            return false;
+                        }
+                        if (!Removed(removed,next[spur])){     // 先尝试直接沿反向最短路树走到终点
+                            out.push_back(spur);
+                            for (uint32_t v=spur;v!=target;){
+                                v=next[v];
+                                if (blocked[v]==blockEpoch){
+                                    break;
+                                }
+                                out.push_back(v);
+                            }
+                            if (out.back()==target){
+                                return true;
+                            }
+                            out.clear();
+                        }
+                        epoch++;
+                        std::priority_queue<std::pair<D,uint32_t>,std::vector<std::pair<D,uint32_t>>,std::greater<>> pq;
+                        g[spur]=0;
+                        from[spur]=None;
+                        seen[spur]=epoch;
+                        pq.push({h[spur],spur});
+                        while (!pq.empty()){
+                            auto [f,u]=pq.top();
+                            pq.pop();
+                            if (f>g[u]+h[u]){
+                                continue;
+                            }
+                            if (u==target){
+                                for (uint32_t v=target;v!=None;v=from[v]){
+                                    out.push_back(v);
+                                }
+                                std::reverse(out.begin(),out.end());
+                                return true;
+                            }
+                            for (size_t k=csr.offset[u];k<csr.offset[u+1];k++){
+                                uint32_t v=csr.to[k];
+                                if (blocked[v]==blockEpoch||h[v]==INF||(u==spur&&Removed(removed,v))){
+                                    continue;
+                                }
+                                D ng=g[u]+csr.weight[k];
+                                if (seen[v]!=epoch||ng<g[v]){
+                                    seen[v]=epoch;
+                                    g[v]=ng;
+                                    from[v]=u;
+                                    pq.push({ng+h[v],v});
+                                }
+                            }
+                        }
+                        return false;
+                    }
+            };
+        }
+
+        template <typename W,typename Dir>
+        std::vector<std::pair<PathWeight<W>,std::vector<std::string>>> KShortestPaths(const BasicLGraph<W,Dir>& graph,const std::string& xName,const std::string& yName,size_t k)
+        {
+            using D=PathWeight<W>;
+            std::vector <std::pair<D,std::vector<std::string>>> res;
+            if (!k){
+                return res;
+            }
+            auto first=ShortestPathwithTrace(graph,xName,yName);
+            if (first.first<0){
+                return res;
+            }
+            res.push_back(std::move(first));
+            if (k==1){
+                return res;
+            }
+
+            struct Route
+            {
+                D cost;
+                std::vector <uint32_t> path;
+                size_t dev;     // 与父路径的偏离位置，之前的前缀已由父路径展开过
+            };
+            auto Worse=[](const Route& a,const Route& b){ return std::tie(a.cost,a.path)>std::tie(b.cost,b.path); };
+
+            const CsrSnapshot<W> csr=MakeSnapshot(graph);
+            CsrSnapshot<W> rcsr;
+            if constexpr (Dir::directed){
+                rcsr=MakeSnapshot(graph,true);
+            }
+            const std::map<std::string,Vertex>& map=graph.Map();
+            SpurSearch<W> search(csr,Dir::directed ? rcsr : csr,map.at(yName));
+
+            Route best{res[0].first,{},0};
+            for (const std::string& name : res[0].second){
+                best.path.push_back(map.at(name));
+            }
+            std::vector <Route> found{best};
+            std::priority_queue<Route,std::vector<Route>,decltype(Worse)> candidates(Worse);
+            std::set <std::vector<uint32_t>> known{best.path};
+            std::vector <uint32_t> removed,spurPath;
+            while (found.size()<k){
+                const std::vector<uint32_t> last=found.back().path;
+                for (size_t i=found.back().dev;i+1<last.size();i++){
+                    removed.clear();
+                    for (const Route& r : found){       // 与当前根路径相同前缀的已选路径，其下一条边不可再走
+                        if (r.path.size()>i+1&&std::equal(last.begin(),last.begin()+i+1,r.path.begin())){
+                            removed.push_back(r.path[i+1]);
+                        }
+                    }
+                    search.Block(last,i);
+                    if (!search.Search(last[i],removed,spurPath)){
+                        continue;
+                    }
+                    std::vector <uint32_t> path(last.begin(),last.begin()+i);
+                    path.insert(path.end(),spurPath.begin(),spurPath.end());
+                    if (known.insert(path).second){
+                        D cost=PathCost(csr,path);
+                        candidates.push(Route{cost,std::move(path),i});
+                    }
+                }
+                if (candidates.empty()){
+                    break;
+                }
+                found.push_back(candidates.top());
+                candidates.pop();
+                std::vector <std::string> names;
+                for (uint32_t v : found.back().path){
+                    names.push_back(graph.Name(v));
+                }
+                res.emplace_back(found.back().cost,std::move(names));
+            }
+            return res;
+        }
+
+        #define INSTANTIATE_K_SHORTEST(W,Dir) \
+            template std::vector<std::pair<PathWeight<W>,std::vector<std::string>>> KShortestPaths(const BasicLGraph<W,Dir>&,const std::string&,const std::string&,size_t);
+        GRAPH_FOR_EACH_INSTANCE(INSTANTIATE_K_SHORTEST)
+        #undef INSTANTIATE_K_SHORTEST
+    }
+}
@@ -0,0 +1,33 @@
+#ifndef CAMPUSNAVIGATION_EDGE_H
+#define CAMPUSNAVIGATION_EDGE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace Graph
+{
+    using Vertex=size_t; // 顶点 ID 类型
+    using EWeight=int;   // 默认边权类型
+
+    template <typename W>
+    struct BasicEdge
+    {
+        Vertex from,to;
+        W weight;
+        BasicEdge()=default;
+        BasicEdge(Vertex f,Vertex t,W w) noexcept : from(f),to(t),weight(w) {}
+    };
+
+    using Edge=BasicEdge<EWeight>;
+
+    // 路径长度的累加类型：整数边权统一用 64 位累加，浮点边权用 double，避免求和溢出
+    template <typename W>
+    using PathWeight=std::conditional_t<std::is_floating_point_v<W>,double,long long>;
+}
+
+// 显式实例化的边权类型
+#define GRAPH_FOR_EACH_WEIGHT(X) \
+    X(std::int16_t) X(std::int32_t) X(std::int64_t) X(float)
+
+#endif // CAMPUSNAVIGATION_EDGE_H
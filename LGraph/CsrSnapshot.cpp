@@ -0,0 +1,53 @@
+#include "CsrSnapshot.h"
+
+namespace Graph
+{
+    template <typename W,typename Dir>
+    CsrSnapshot<W> MakeSnapshot(const BasicLGraph<W,Dir>& graph,bool reverse)
+    {
+        size_t n=graph.VertexCount();
+        CsrSnapshot<W> csr;
+        if (Dir::directed&&reverse){        // 反向图：先按入度分配区间，再把每条边填到终点名下
+            csr.offset.assign(n+1,0);
+            for (Vertex u=0;u<n;u++){
+                for (const BasicEdge<W>& e : graph.Adj(u)){
+                    csr.offset[e.to+1]++;
+                }
+            }
+            for (Vertex u=0;u<n;u++){
+                csr.offset[u+1]+=csr.offset[u];
+            }
+            csr.to.resize(csr.offset[n]);
+            csr.weight.resize(csr.offset[n]);
+            std::vector <size_t> pos(csr.offset.begin(),csr.offset.end()-1);
+            for (Vertex u=0;u<n;u++){
+                for (const BasicEdge<W>& e : graph.Adj(u)){
+                    csr.to[pos[e.to]]=u;
+                    csr.weight[pos[e.to]]=e.weight;
+                    pos[e.to]++;
+                }
+            }
+            return csr;
+        }
+        csr.offset.resize(n+1);
+        csr.offset[0]=0;
+        for (Vertex u=0;u<n;u++){
+            csr.offset[u+1]=csr.offset[u]+graph.Degree(u);
+        }
+        csr.to.resize(csr.offset[n]);
+        csr.weight.resize(csr.offset[n]);
+        for (Vertex u=0;u<n;u++){
+            size_t pos=csr.offset[u];
+            for (const BasicEdge<W>& e : graph.Adj(u)){
+                csr.to[pos]=e.to;
+                csr.weight[pos]=e.weight;
+                pos++;
+            }
+        }
+        return csr;
+    }
+
+    #define INSTANTIATE_SNAPSHOT(W,Dir) template CsrSnapshot<W> MakeSnapshot(const BasicLGraph<W,Dir>&,bool);
+    GRAPH_FOR_EACH_INSTANCE(INSTANTIATE_SNAPSHOT)
+    #undef INSTANTIATE_SNAPSHOT
+}
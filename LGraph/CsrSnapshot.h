@@ -0,0 +1,28 @@
+#ifndef LGRAPH_CSRSNAPSHOT_H
+#define LGRAPH_CSRSNAPSHOT_H
+
+#include <vector>
+#include <cstdint>
+#include "LGraph.h"
+
+namespace Graph
+{
+    // 图的只读压缩快照（CSR）：顶点 u 的出边为 [offset[u],offset[u+1]) 区间内的 to/weight，
+    // 适合需要反复整图扫描或多线程并发读取的算法
+    template <typename W>
+    struct CsrSnapshot
+    {
+        std::vector <size_t> offset;
+        std::vector <uint32_t> to;
+        std::vector <W> weight;
+
+        size_t VertexCount() const noexcept { return offset.empty() ? 0 : offset.size()-1; }
+        size_t Degree(Vertex u) const noexcept { return offset[u+1]-offset[u]; }
+    };
+
+    // 按当前顶点编号生成快照，图被修改后需重新生成；reverse 为真时生成反向图（无向图与正向相同）
+    template <typename W,typename Dir>
+    CsrSnapshot<W> MakeSnapshot(const BasicLGraph<W,Dir>& graph,bool reverse=false);
+}
+
+#endif // LGRAPH_CSRSNAPSHOT_H
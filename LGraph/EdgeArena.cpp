@@ -0,0 +1,202 @@
+#include <algorithm>
+#include "EdgeArena.h"
+#include "GraphException.h"
+
+namespace Graph
+{
+    template <typename W>
+    AdjBlock EdgeArena<W>::Allocate(uint8_t cls)
+    {
+        if (cls>=ClassCount){
+            throw GraphException("邻接块容量超出上限");
+        }
+        AdjBlock b;
+        if (!freeList[cls].empty()){
+            b=freeList[cls].back();
+            freeList[cls].pop_back();
+            return b;
+        }
+        size_t cap=Capacity(cls);
+        if (cap>SlabEdges){     // 大块独占一个 slab
+            b.slab=slabs.size();
+            b.offset=0;
+            slabs.push_back(std::make_shared<Slab>(cap));
+        }
+        else {
+            if (cursor+cap>SlabEdges){
+                if (!slabs.empty()&&cursor<SlabEdges){
+                    Carve(openSlab,cursor,SlabEdges-cursor);
+                }
+                openSlab=slabs.size();
+                cursor=0;
+                slabs.push_back(std::make_shared<Slab>(SlabEdges));
+            }
+            b.slab=openSlab;
+            b.offset=cursor;
+            cursor+=cap;
+        }
+        b.size=0;
+        b.cls=cls;
+        return b;
+    }
+
+    template <typename W>
+    void EdgeArena<W>::Carve(uint32_t slab,size_t offset,size_t len)
+    {
+        for (uint8_t cls=ClassCount;cls-->0;){     // 从大到小切分，剩余长度总是 MinBlock 的倍数
+            size_t cap=Capacity(cls);
+            while (cap<=SlabEdges&&len>=cap){
+                AdjBlock b;
+                b.slab=slab;
+                b.offset=offset;
+                b.cls=cls;
+                freeList[cls].push_back(b);
+                offset+=cap;
+                len-=cap;
+            }
+        }
+    }
+
+    template <typename W>
+    typename EdgeArena<W>::Slab& EdgeArena<W>::Mutable(uint32_t slab)
+    {
+        std::shared_ptr<Slab>& s=slabs[slab];
+        if (s.use_count()>1){
+            s=std::make_shared<Slab>(*s);
+        }
+        else {
+            // 其他副本可能刚在别的线程释放了这个 slab，与其之前的读取建立先后关系后再写
+            std::atomic_thread_fence(std::memory_order_acquire);
+        }
+        return *s;
+    }
+
+    template <typename W>
+    size_t EdgeArena<W>::Find(const AdjBlock& b,Vertex target) const noexcept
+    {
+        if (b.cls==AdjBlock::NoClass){
+            return NoPos;
+        }
+        const uint32_t* to=slabs[b.slab]->to.data()+b.offset;
+        for (size_t i=0;i<b.size;i++){
+            if (to[i]==target){
+                return i;
+            }
+        }
+        return NoPos;
+    }
+
+    template <typename W>
+    void EdgeArena<W>::PushBack(AdjBlock& b,Vertex target,W weight)
+    {
+        if (b.cls==AdjBlock::NoClass){
+            b=Allocate(0);
+        }
+        else if (b.size==Capacity(b.cls)){
+            AdjBlock nb=Allocate(b.cls+1);
+            const Slab& from=*slabs[b.slab];
+            Slab& to=Mutable(nb.slab);
+            std::copy_n(from.to.begin()+b.offset,b.size,to.to.begin()+nb.offset);
+            std::copy_n(from.weight.begin()+b.offset,b.size,to.weight.begin()+nb.offset);
+            nb.size=b.size;
+            Release(b);
+            b=nb;
+        }
+        Slab& s=Mutable(b.slab);
+        s.to[b.offset+b.size]=target;
+        s.weight[b.offset+b.size]=weight;
+        b.size++;
+    }
+
+    template <typename W>
+    size_t EdgeArena<W>::EraseTarget(AdjBlock& b,Vertex target)
+    {
+        if (b.cls==AdjBlock::NoClass){
+            return 0;
+        }
+        Slab& s=Mutable(b.slab);
+        size_t kept=0;
+        for (size_t i=0;i<b.size;i++){
+            if (s.to[b.offset+i]!=target){
+                s.to[b.offset+kept]=s.to[b.offset+i];
+                s.weight[b.offset+kept]=s.weight[b.offset+i];
+                kept++;
+            }
+        }
+        size_t removed=b.size-kept;
+        b.size=kept;
+        if (!b.size){
+            Release(b);
+        }
+        return removed;
+    }
+
+    template <typename W>
+    size_t EdgeArena<W>::Remap(AdjBlock& b,const std::vector<uint32_t>& newId)
+    {
+        if (b.cls==AdjBlock::NoClass){
+            return 0;
+        }
+        Slab& s=Mutable(b.slab);
+        size_t kept=0;
+        for (size_t i=0;i<b.size;i++){
+            uint32_t to=newId[s.to[b.offset+i]];
+            if (to!=NoVertex){
+                s.to[b.offset+kept]=to;
+                s.weight[b.offset+kept]=s.weight[b.offset+i];
+                kept++;
+            }
+        }
+        size_t removed=b.size-kept;
+        b.size=kept;
+        if (!b.size){
+            Release(b);
+        }
+        return removed;
+    }
+
+    template <typename W>
+    void EdgeArena<W>::Release(AdjBlock& b)
+    {
+        if (b.cls!=AdjBlock::NoClass){
+            b.size=0;
+            freeList[b.cls].push_back(b);
+        }
+        b=AdjBlock();
+    }
+
+    template <typename W>
+    void EdgeArena<W>::Clear() noexcept
+    {
+        slabs.clear();
+        for (std::vector<AdjBlock>& fl : freeList){
+            fl.clear();
+        }
+        openSlab=0;
+        cursor=SlabEdges;
+    }
+
+    template <typename W>
+    size_t EdgeArena<W>::ReservedBytes() const noexcept
+    {
+        size_t bytes=0;
+        for (const std::shared_ptr<Slab>& s : slabs){
+            bytes+=s->to.size()*(sizeof(uint32_t)+sizeof(W));
+        }
+        return bytes;
+    }
+
+    template <typename W>
+    size_t EdgeArena<W>::SharedSlabs() const noexcept
+    {
+        size_t count=0;
+        for (const std::shared_ptr<Slab>& s : slabs){
+            count+=s.use_count()>1;
+        }
+        return count;
+    }
+
+    #define INSTANTIATE_EDGE_ARENA(W) template class EdgeArena<W>;
+    GRAPH_FOR_EACH_WEIGHT(INSTANTIATE_EDGE_ARENA)
+    #undef INSTANTIATE_EDGE_ARENA
+}
@@ -0,0 +1,130 @@
+#ifndef LGRAPH_EDGEARENA_H
+#define LGRAPH_EDGEARENA_H
+
+#include <array>
+#include <vector>
+#include <span>
+#include <memory>
+#include <atomic>
+#include <cstdint>
+#include <iterator>
+#include "Edge.h"
+
+namespace Graph
+{
+    // 邻接块句柄：指向某个 slab 中一段连续存放的边
+    struct AdjBlock
+    {
+        static constexpr uint8_t NoClass=0xFF;
+        uint32_t slab=0;        // 所在 slab 编号
+        uint32_t offset=0;      // slab 内起始位置
+        uint32_t size=0;        // 已用边数
+        uint8_t cls=NoClass;    // 容量等级，容量为 MinBlock<<cls
+    };
+
+    // 一个顶点邻接边的只读视图，迭代时按值生成 BasicEdge（起点即所属顶点）
+    template <typename W>
+    class AdjRange
+    {
+        private:
+            Vertex from=0;
+            const uint32_t* to=nullptr;
+            const W* weight=nullptr;
+            size_t count=0;
+
+        public:
+            class iterator
+            {
+                private:
+                    Vertex from=0;
+                    const uint32_t* to=nullptr;
+                    const W* weight=nullptr;
+                public:
+                    using iterator_category=std::input_iterator_tag;
+                    using value_type=BasicEdge<W>;
+                    using difference_type=std::ptrdiff_t;
+                    using reference=BasicEdge<W>;
+                    using pointer=void;
+
+                    iterator()=default;
+                    iterator(Vertex f,const uint32_t* t,const W* w) noexcept : from(f),to(t),weight(w) {}
+                    BasicEdge<W> operator*() const noexcept { return BasicEdge<W>(from,*to,*weight); }
+                    iterator& operator++() noexcept { to++; weight++; return *this; }
+                    iterator operator++(int) noexcept { iterator t=*this; ++*this; return t; }
+                    bool operator==(const iterator& o) const noexcept { return to==o.to; }
+            };
+
+            AdjRange()=default;
+            AdjRange(Vertex f,const uint32_t* t,const W* w,size_t n) noexcept : from(f),to(t),weight(w),count(n) {}
+
+            BasicEdge<W> operator[](size_t i) const noexcept { return BasicEdge<W>(from,to[i],weight[i]); }
+            iterator begin() const noexcept { return iterator(from,to,weight); }
+            iterator end() const noexcept { return iterator(from,to+count,weight+count); }
+            size_t size() const noexcept { return count; }
+            bool empty() const noexcept { return !count; }
+    };
+
+    // 邻接表的 slab 分配器：边按容量等级（4,8,16,...）成块存放在固定大小的 slab 中，
+    // 释放的块挂到对应等级的空闲链表上复用，避免频繁增删边时的逐节点堆分配。
+    // 每个 slab 内终点与边权分列存放，边权类型越小，每条边占用越少。
+    // 复制 arena 时 slab 在副本之间共享，写入某个 slab 前若仍被共享则先复制该 slab（写时复制）
+    template <typename W>
+    class EdgeArena
+    {
+        public:
+            static constexpr size_t SlabEdges=1024;    // 每个普通 slab 可容纳的边数
+            static constexpr size_t MinBlock=4;        // 最小块容量
+            static constexpr size_t ClassCount=26;     // 容量等级数，超过 SlabEdges 的块独占一个 slab
+            static constexpr size_t NoPos=static_cast<size_t>(-1);
+            static constexpr uint32_t NoVertex=static_cast<uint32_t>(-1);
+
+        private:
+            struct Slab
+            {
+                std::vector<uint32_t> to;
+                std::vector<W> weight;
+                explicit Slab(size_t n) : to(n),weight(n) {}
+            };
+
+            std::vector<std::shared_ptr<Slab>> slabs;
+            std::array<std::vector<AdjBlock>,ClassCount> freeList;   // 每个容量等级的空闲块
+            uint32_t openSlab=0;        // 当前用于顺序切分的 slab
+            size_t cursor=SlabEdges;    // openSlab 中下一个可用位置（满时需新开 slab）
+
+            AdjBlock Allocate(uint8_t cls);     // 分配一个指定等级的空块
+            void Carve(uint32_t slab,size_t offset,size_t len);     // 把 slab 尾部剩余空间切成空闲块
+            Slab& Mutable(uint32_t slab);       // 取得可写的 slab，被其他副本共享时先复制一份
+
+        public:
+            static constexpr size_t Capacity(uint8_t cls) noexcept { return MinBlock<<cls; }
+
+            AdjRange<W> View(Vertex from,const AdjBlock& b) const noexcept
+            {
+                if (b.cls==AdjBlock::NoClass){
+                    return AdjRange<W>();
+                }
+                const Slab& s=*slabs[b.slab];
+                return AdjRange<W>(from,s.to.data()+b.offset,s.weight.data()+b.offset,b.size);
+            }
+            std::span<uint32_t> Targets(const AdjBlock& b)
+            {
+                return b.cls==AdjBlock::NoClass ? std::span<uint32_t>() : std::span<uint32_t>(Mutable(b.slab).to.data()+b.offset,b.size);
+            }
+            std::span<W> Weights(const AdjBlock& b)
+            {
+                return b.cls==AdjBlock::NoClass ? std::span<W>() : std::span<W>(Mutable(b.slab).weight.data()+b.offset,b.size);
+            }
+
+            size_t Find(const AdjBlock& b,Vertex target) const noexcept;    // 查找终点为 target 的边在块内的位置，没有则返回 NoPos
+            void PushBack(AdjBlock& b,Vertex target,W weight);              // 在块尾追加一条边，满时换到更大等级的块
+            size_t EraseTarget(AdjBlock& b,Vertex target);                  // 删除终点为 target 的边（保持其余边的顺序），块被删空时归还
+            size_t Remap(AdjBlock& b,const std::vector<uint32_t>& newId);   // 按 newId 重写终点，映射为 NoVertex 的边被删除，返回删除条数
+            void Release(AdjBlock& b);                                      // 归还整个块
+            void Clear() noexcept;                                          // 清空所有 slab
+
+            size_t ReservedBytes() const noexcept;      // slab 占用的总字节数
+            size_t SharedSlabs() const noexcept;        // 与其他副本共享的 slab 数
+    };
+}
+
+#endif // LGRAPH_EDGEARENA_H
@@ -1,75 +1,112 @@
 #include <algorithm>
+#include <atomic>
+#include <limits>
 #include "LGraph.h"
 
 namespace Graph
 {
-    bool LGraph::ExistVertex(const std::string& name) const
+    template <typename W,typename Dir>
+    bool BasicLGraph<W,Dir>::ExistVertex(const std::string& name) const
     {
-        return ver_map.find(name)!=ver_map.end();
+        return cold->ver_map.find(name)!=cold->ver_map.end();
     }
 
-    bool LGraph::ExistEdge(const std::string& u,const std::string& v) const
+    template <typename W,typename Dir>
+    bool BasicLGraph<W,Dir>::ExistEdge(const std::string& u,const std::string& v) const
     {
-        auto it_u=ver_map.find(u);
-        auto it_v=ver_map.find(v);
-        if (it_u==ver_map.end()||it_v==ver_map.end()){
+        auto it_u=cold->ver_map.find(u);
+        auto it_v=cold->ver_map.find(v);
+        if (it_u==cold->ver_map.end()||it_v==cold->ver_map.end()){
             return false;
         }
-        Vertex uid=it_u->second;
-        Vertex vid=it_v->second;
-        for (const Edge& e : ver_list[uid].adj){
-            if (e.to==vid){
-                return true;
-            }
-        }
-        return false;
+        return arena.Find(adj[it_u->second],it_v->second)!=EdgeArena<W>::NoPos;
     }
 
-    void LGraph::InsertVertex(const LocationInfo& vertexInfo)
+    template <typename W,typename Dir>
+    void BasicLGraph<W,Dir>::InsertVertex(const LocationInfo& vertexInfo)
     {
+        if (batching){
+            pending.push_back({PendingOp::AddVertex,vertexInfo.name,vertexInfo.type,W{},vertexInfo.visitTime});
+            return;
+        }
         if (ExistVertex(vertexInfo.name)){
             throw GraphException("顶点"+vertexInfo.name+"已存在");
         }
-        ver_list.emplace_back(vertexInfo);
-        ver_map[vertexInfo.name]=vertNum++;
+        if (vertNum>=std::numeric_limits<uint32_t>::max()){
+            throw GraphException("顶点数量超出上限");
+        }
+        adj.emplace_back();
+        typeOf.push_back(InternType(vertexInfo.type));
+        visitTime.push_back(vertexInfo.visitTime);
+        ColdData& c=MutableCold();
+        c.names.push_back(vertexInfo.name);
+        c.ver_map[vertexInfo.name]=vertNum++;
+        revision++;
     }
 
-    void LGraph::DeleteVertex(const std::string& name)
+    template <typename W,typename Dir>
+    void BasicLGraph<W,Dir>::DeleteVertex(const std::string& name)
     {
-        auto it=ver_map.find(name);
-        if (it==ver_map.end()){
+        if (batching){
+            pending.push_back({PendingOp::RemoveVertex,name,{},{}});
+            return;
+        }
+        auto it=cold->ver_map.find(name);
+        if (it==cold->ver_map.end()){
             throw GraphException("顶点"+name+"不存在");
         }
-        Vertex id=it->second;
-        for (Edge& e : ver_list[id].adj){
-            std::list <Edge>& adjList=ver_list[e.to].adj;
-            adjList.remove_if([id](const Edge& ed){ return ed.to==id; });
-            edgeNum--;
-        }
-        ver_list.erase(ver_list.begin()+id);
-        ver_map.erase(it);
-        vertNum--;
-        for (auto& [key,val] : ver_map){    // 更新映射中所有 ID > id 的值
-            if (val>id){
-                val--;
-            }
-        }
-        for (VertexNode& v : ver_list){     // 更新所有剩余边的 from/to
-            for (Edge& e : v.adj){
-                if (e.from>id){
-                    e.from--;
-                }
-                if (e.to>id){
-                    e.to--;
+        std::vector <char> dead(vertNum,0);
+        dead[it->second]=1;
+        RemoveVertices(dead);
+        revision++;
+    }
+
+    template <typename W,typename Dir>
+    void BasicLGraph<W,Dir>::RemoveVertices(const std::vector<char>& dead)
+    {
+        std::vector <uint32_t> newId(vertNum);
+        uint32_t next=0;
+        for (Vertex u=0;u<vertNum;u++){
+            newId[u]=dead[u] ? EdgeArena<W>::NoVertex : next++;
+        }
+        ColdData& c=MutableCold();
+        size_t stored=0;    // 剩余的邻接项数
+        for (Vertex u=0;u<vertNum;u++){
+            if (dead[u]){
+                arena.Release(adj[u]);
+                auto it=c.ver_map.find(c.names[u]);
+                if (it!=c.ver_map.end()&&it->second==u){     // 同名顶点可能已在同一批中重新插入
+                    c.ver_map.erase(it);
                 }
+                continue;
+            }
+            arena.Remap(adj[u],newId);      // 删去指向被删顶点的边并改写终点编号
+            stored+=adj[u].size;
+            Vertex id=newId[u];
+            adj[id]=adj[u];
+            typeOf[id]=typeOf[u];
+            visitTime[id]=visitTime[u];
+            if (id!=u){
+                c.names[id]=std::move(c.names[u]);
+                c.ver_map[c.names[id]]=id;
             }
         }
+        vertNum=next;
+        adj.resize(vertNum);
+        typeOf.resize(vertNum);
+        visitTime.resize(vertNum);
+        c.names.resize(vertNum);
+        edgeNum=Dir::directed ? stored : stored/2;
     }
 
-    void LGraph::UpdateVertex(const std::string& oldName,const LocationInfo& newInfo)
+    template <typename W,typename Dir>
+    void BasicLGraph<W,Dir>::UpdateVertex(const std::string& oldName,const LocationInfo& newInfo)
     {
-        auto it=ver_map.find(oldName);
-        if (it==ver_map.end()){
+        if (batching){
+            throw GraphException("批量修改中不支持更新顶点");
+        }
+        auto it=cold->ver_map.find(oldName);
+        if (it==cold->ver_map.end()){
             throw GraphException("顶点"+oldName+"不存在");
         }
         Vertex id=it->second;
@@ -77,37 +114,84 @@ namespace Graph
 
         // 处理顶点重命名
         if (oldName!=newName){
-            if (ver_map.find(newName)!=ver_map.end()){
+            if (cold->ver_map.find(newName)!=cold->ver_map.end()){
                 throw GraphException("新名称"+newName+"已存在");
             }
-            ver_map.erase(oldName);
-            ver_map[newName]=id;
+            ColdData& c=MutableCold();
+            c.ver_map.erase(oldName);
+            c.ver_map[newName]=id;
+            c.names[id]=newName;
         }
-        ver_list[id].info=newInfo;
+        typeOf[id]=InternType(newInfo.type);
+        visitTime[id]=newInfo.visitTime;
+        revision++;
     }
 
-    LocationInfo LGraph::GetVertex(const std::string& name) const
+    template <typename W,typename Dir>
+    LocationView BasicLGraph<W,Dir>::GetVertex(const std::string& name) const
     {
-        auto it=ver_map.find(name);
-        if (it==ver_map.end()){
+        auto it=cold->ver_map.find(name);
+        if (it==cold->ver_map.end()){
             throw GraphException("顶点"+name+"不存在");
         }
-        return ver_list[it->second].info;
+        return GetVertex(it->second);
     }
 
-    LocationInfo LGraph::GetVertex(Vertex vertex) const
+    template <typename W,typename Dir>
+    LocationView BasicLGraph<W,Dir>::GetVertex(Vertex vertex) const
     {
         if (vertex>=vertNum){
             throw GraphException("顶点ID越界: "+std::to_string(vertex));
         }
-        return ver_list[vertex].info;
+        return LocationView{cold->names[vertex],cold->typeNames[typeOf[vertex]],visitTime[vertex]};
     }
 
-    void LGraph::InsertEdge(const std::string& u,const std::string& v,EWeight weight)
+    template <typename W,typename Dir>
+    TypeId BasicLGraph<W,Dir>::InternType(const std::string& type)
     {
-        auto it_u=ver_map.find(u);
-        auto it_v=ver_map.find(v);
-        if (it_u==ver_map.end()||it_v==ver_map.end()){
+        auto it=cold->type_map.find(type);
+        if (it!=cold->type_map.end()){
+            return it->second;
+        }
+        ColdData& c=MutableCold();
+        TypeId id=c.typeNames.size();
+        c.type_map.emplace(type,id);
+        c.typeNames.push_back(type);
+        return id;
+    }
+
+    template <typename W,typename Dir>
+    typename BasicLGraph<W,Dir>::ColdData& BasicLGraph<W,Dir>::MutableCold()
+    {
+        if (cold.use_count()>1){
+            cold=std::make_shared<ColdData>(*cold);
+        }
+        else {
+            std::atomic_thread_fence(std::memory_order_acquire);    // 同 EdgeArena::Mutable
+        }
+        return *cold;
+    }
+
+    template <typename W,typename Dir>
+    std::optional<TypeId> BasicLGraph<W,Dir>::FindType(const std::string& type) const
+    {
+        auto it=cold->type_map.find(type);
+        if (it==cold->type_map.end()){
+            return std::nullopt;
+        }
+        return it->second;
+    }
+
+    template <typename W,typename Dir>
+    void BasicLGraph<W,Dir>::InsertEdge(const std::string& u,const std::string& v,W weight)
+    {
+        if (batching){
+            pending.push_back({PendingOp::AddEdge,u,v,weight});
+            return;
+        }
+        auto it_u=cold->ver_map.find(u);
+        auto it_v=cold->ver_map.find(v);
+        if (it_u==cold->ver_map.end()||it_v==cold->ver_map.end()){
             throw GraphException("插入边时，顶点不存在");
         }
         Vertex uid=it_u->second;
@@ -116,16 +200,24 @@ namespace Graph
             UpdateEdge(u,v,weight);
             return;
         }
-        ver_list[uid].adj.emplace_back(uid,vid,weight);
-        ver_list[vid].adj.emplace_back(vid,uid,weight);
+        arena.PushBack(adj[uid],vid,weight);
+        if constexpr (!Dir::directed){
+            arena.PushBack(adj[vid],uid,weight);
+        }
         edgeNum++;
+        revision++;
     }
 
-    void LGraph::DeleteEdge(const std::string& u,const std::string& v)
+    template <typename W,typename Dir>
+    void BasicLGraph<W,Dir>::DeleteEdge(const std::string& u,const std::string& v)
     {
-        auto it_u=ver_map.find(u);
-        auto it_v=ver_map.find(v);
-        if (it_u==ver_map.end()||it_v==ver_map.end()){
+        if (batching){
+            pending.push_back({PendingOp::RemoveEdge,u,v,{}});
+            return;
+        }
+        auto it_u=cold->ver_map.find(u);
+        auto it_v=cold->ver_map.find(v);
+        if (it_u==cold->ver_map.end()||it_v==cold->ver_map.end()){
             throw GraphException("删除边时，顶点不存在");
         }
         if (!ExistEdge(u,v)){
@@ -137,52 +229,70 @@ namespace Graph
         edgeNum--;
     }
 
-    void LGraph::DeleteEdge(Vertex u,Vertex v)
+    template <typename W,typename Dir>
+    void BasicLGraph<W,Dir>::DeleteEdge(Vertex u,Vertex v)
     {
-        std::list <Edge>& adj_u=ver_list[u].adj;
-        adj_u.remove_if([v](const Edge& e) { return e.to==v; });
-        std::list <Edge>& adj_v=ver_list[v].adj;
-        adj_v.remove_if([u](const Edge& e) { return e.to==u; });
+        if (batching){
+            throw GraphException("批量修改中不能按顶点 ID 删除边");
+        }
+        arena.EraseTarget(adj[u],v);
+        if constexpr (!Dir::directed){
+            arena.EraseTarget(adj[v],u);
+        }
+        revision++;
     }
 
-    void LGraph::UpdateEdge(const std::string& u,const std::string& v,EWeight newWeight)
+    template <typename W,typename Dir>
+    void BasicLGraph<W,Dir>::UpdateEdge(const std::string& u,const std::string& v,W newWeight)
     {
-        auto it_u=ver_map.find(u);
-        auto it_v=ver_map.find(v);
-        if (it_u==ver_map.end()||it_v==ver_map.end()){
-            throw GraphException("更新边时，顶点不存在");
+        if (batching){
+            pending.push_back({PendingOp::SetWeight,u,v,newWeight});
+            return;
         }
-        Vertex uid=it_u->second;
-        Vertex vid=it_v->second;
-        bool found=false;
-        for (Edge& e : ver_list[uid].adj){
-            if (e.to==vid){
-                e.weight=newWeight;
-                found=true;
-                break;
-            }
+        auto it_u=cold->ver_map.find(u);
+        auto it_v=cold->ver_map.find(v);
+        if (it_u==cold->ver_map.end()||it_v==cold->ver_map.end()){
+            throw GraphException("更新边时，顶点不存在");
         }
-        if (!found){
+        if (!SetWeight(it_u->second,it_v->second,newWeight)){
             throw GraphException("要更新的边"+u+" - "+v+"不存在");
         }
-        for (Edge& e : ver_list[vid].adj){
-            if (e.to==uid){
-                e.weight=newWeight;
-                break;
+        revision++;
+    }
+
+    template <typename W,typename Dir>
+    bool BasicLGraph<W,Dir>::SetWeight(Vertex u,Vertex v,W weight)
+    {
+        if (arena.Find(adj[u],v)==EdgeArena<W>::NoPos){
+            return false;
+        }
+        auto Write=[&](Vertex from,Vertex to){
+            std::span<uint32_t> targets=arena.Targets(adj[from]);
+            std::span<W> weights=arena.Weights(adj[from]);
+            for (size_t i=0;i<targets.size();i++){
+                if (targets[i]==to){
+                    weights[i]=weight;
+                }
             }
+        };
+        Write(u,v);
+        if (!Dir::directed&&u!=v){
+            Write(v,u);
         }
+        return true;
     }
 
-    EWeight LGraph::GetEdge(const std::string& u,const std::string& v) const
+    template <typename W,typename Dir>
+    W BasicLGraph<W,Dir>::GetEdge(const std::string& u,const std::string& v) const
     {
-        auto it_u=ver_map.find(u);
-        auto it_v=ver_map.find(v);
-        if (it_u==ver_map.end()||it_v==ver_map.end()){
+        auto it_u=cold->ver_map.find(u);
+        auto it_v=cold->ver_map.find(v);
+        if (it_u==cold->ver_map.end()||it_v==cold->ver_map.end()){
             throw GraphException("查询边时，顶点不存在");
         }
         Vertex uid=it_u->second;
         Vertex vid=it_v->second;
-        for (const Edge& e : ver_list[uid].adj){
+        for (const EdgeType& e : Adj(uid)){
             if (e.to==vid){
                 return e.weight;
             }
@@ -190,18 +300,175 @@ namespace Graph
         throw GraphException("要查询的边"+u+" - "+v+"不存在");
     }
 
-    std::vector<Edge> LGraph::SortedEdges(std::function<bool(const EWeight&,const EWeight&)> cmp) const
+    template <typename W,typename Dir>
+    void BasicLGraph<W,Dir>::BeginBatch()
+    {
+        if (batching){
+            throw GraphException("已在批量修改中");
+        }
+        batching=true;
+        pending.clear();
+    }
+
+    template <typename W,typename Dir>
+    void BasicLGraph<W,Dir>::Commit()
     {
-        std::vector <Edge> edges;
+        if (!batching){
+            throw GraphException("没有进行中的批量修改");
+        }
+        std::vector <PendingOp> ops=std::move(pending);
+        Rollback();
+
+        // 第一遍：按原顺序解析名称并校验顶点，新顶点依次编号在现有顶点之后，边操作归一成 <起点, 终点, 序号>
+        struct EdgeOp
+        {
+            Vertex u,v;
+            size_t seq;
+            typename PendingOp::Kind kind;
+            W weight;
+        };
+        std::vector <EdgeOp> edgeOps;
+        std::vector <char> dead(vertNum,0);
+        bool anyDead=false;
+        std::map <std::string,Vertex> added;    // 本批新插入的顶点
+        std::vector <const PendingOp*> addOps;
+        auto Lookup=[&](const std::string& name)->Vertex{
+            auto ia=added.find(name);
+            if (ia!=added.end()&&!dead[ia->second]){
+                return ia->second;
+            }
+            auto it=cold->ver_map.find(name);
+            if (it!=cold->ver_map.end()&&!dead[it->second]){
+                return it->second;
+            }
+            return EdgeArena<W>::NoVertex;
+        };
+        auto Resolve=[&](const std::string& name){
+            Vertex id=Lookup(name);
+            if (id==EdgeArena<W>::NoVertex){
+                throw GraphException("顶点"+name+"不存在");
+            }
+            return id;
+        };
+        for (size_t i=0;i<ops.size();i++){
+            const PendingOp& op=ops[i];
+            if (op.kind==PendingOp::AddVertex){
+                if (Lookup(op.u)!=EdgeArena<W>::NoVertex){
+                    throw GraphException("顶点"+op.u+"已存在");
+                }
+                if (dead.size()>=std::numeric_limits<uint32_t>::max()){
+                    throw GraphException("顶点数量超出上限");
+                }
+                added[op.u]=dead.size();
+                addOps.push_back(&op);
+                dead.push_back(0);
+                continue;
+            }
+            if (op.kind==PendingOp::RemoveVertex){
+                dead[Resolve(op.u)]=1;
+                anyDead=true;
+                continue;
+            }
+            Vertex uid=Resolve(op.u);
+            Vertex vid=Resolve(op.v);
+            if (!Dir::directed&&uid>vid){   // 无向边统一成 u<=v
+                std::swap(uid,vid);
+            }
+            edgeOps.push_back({uid,vid,i,op.kind,op.weight});
+        }
+
+        // 第二遍：按边排序，对每条边依次折叠其所有操作得到最终状态，同时校验删除/更新的边是否存在
+        std::stable_sort(edgeOps.begin(),edgeOps.end(),[](const EdgeOp& a,const EdgeOp& b){
+            return a.u!=b.u ? a.u<b.u : a.v<b.v;
+        });
+        struct EdgeChange
+        {
+            Vertex u,v;
+            bool before,after;
+            W weight;
+        };
+        std::vector <EdgeChange> changes;
+        for (size_t i=0;i<edgeOps.size();){
+            Vertex u=edgeOps[i].u,v=edgeOps[i].v;
+            size_t pos=u<vertNum&&v<vertNum ? arena.Find(adj[u],v) : EdgeArena<W>::NoPos;   // 涉及新顶点的边原先必不存在
+            bool before=pos!=EdgeArena<W>::NoPos;
+            bool exists=before;
+            W weight=before ? arena.View(u,adj[u])[pos].weight : W{};
+            for (;i<edgeOps.size()&&edgeOps[i].u==u&&edgeOps[i].v==v;i++){
+                const EdgeOp& op=edgeOps[i];
+                const PendingOp& src=ops[op.seq];
+                if (op.kind==PendingOp::AddEdge){
+                    exists=true;
+                    weight=op.weight;
+                }
+                else if (!exists){
+                    throw GraphException((op.kind==PendingOp::RemoveEdge ? "要删除的边" : "要更新的边")+src.u+" - "+src.v+"不存在");
+                }
+                else if (op.kind==PendingOp::RemoveEdge){
+                    exists=false;
+                }
+                else {
+                    weight=op.weight;
+                }
+            }
+            if (!dead[u]&&!dead[v]&&(before||exists)){    // 端点被删的边随顶点一起处理
+                changes.push_back({u,v,before,exists,weight});
+            }
+        }
+
+        // 校验全部通过后才开始修改，先追加新顶点使边能引用它们
+        if (!addOps.empty()){
+            ColdData& c=MutableCold();
+            for (const PendingOp* op : addOps){
+                adj.emplace_back();
+                typeOf.push_back(InternType(op->v));
+                visitTime.push_back(op->visitTime);
+                c.names.push_back(op->u);
+                c.ver_map[op->u]=vertNum++;
+            }
+        }
+        for (const EdgeChange& c : changes){
+            if (c.before&&c.after){
+                SetWeight(c.u,c.v,c.weight);
+            }
+            else if (c.before){
+                arena.EraseTarget(adj[c.u],c.v);
+                if constexpr (!Dir::directed){
+                    arena.EraseTarget(adj[c.v],c.u);
+                }
+                edgeNum--;
+            }
+            else {
+                arena.PushBack(adj[c.u],c.v,c.weight);
+                if constexpr (!Dir::directed){
+                    arena.PushBack(adj[c.v],c.u,c.weight);
+                }
+                edgeNum++;
+            }
+        }
+        if (anyDead){
+            RemoveVertices(dead);
+        }
+        revision++;
+    }
+
+    template <typename W,typename Dir>
+    std::vector<BasicEdge<W>> BasicLGraph<W,Dir>::SortedEdges(std::function<bool(const W&,const W&)> cmp) const
+    {
+        std::vector <EdgeType> edges;
         edges.reserve(edgeNum);
         for (Vertex u=0;u<vertNum;u++){
-            for (const Edge& e : ver_list[u].adj){
-                if (u<e.to){
+            for (const EdgeType& e : Adj(u)){
+                if (Dir::directed||u<e.to){
                     edges.push_back(e);
                 }
             }
         }
-        std::sort(edges.begin(),edges.end(),[&](const Edge& e1,const Edge& e2){ return e1.weight>e2.weight; });
+        std::sort(edges.begin(),edges.end(),[&](const EdgeType& e1,const EdgeType& e2){ return e1.weight>e2.weight; });
         return edges;
     }
-}
\ No newline at end of file
+
+    #define INSTANTIATE_LGRAPH(W,Dir) template class BasicLGraph<W,Dir>;
+    GRAPH_FOR_EACH_INSTANCE(INSTANTIATE_LGRAPH)
+    #undef INSTANTIATE_LGRAPH
+}
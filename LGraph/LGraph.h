@@ -1,71 +1,124 @@
 #ifndef LGRAPH_LGRAPH_H
 #define LGRAPH_LGRAPH_H
 
-#include <list>
 #include <vector>
 #include <map>
+#include <cstdint>
+#include <optional>
+#include <memory>
 #include <string>
 #include <functional>
+#include "Edge.h"
+#include "EdgeArena.h"
 #include "LocationInfo.h"
 #include "GraphException.h"
 
 namespace Graph
 {
-    using Vertex=size_t; // 顶点 ID 类型
-    using EWeight=int;   // 边权类型
+    using TypeId=uint32_t;  // 地点类型编号
 
-    struct Edge
-    {
-        Vertex from,to;
-        EWeight weight;
-        Edge(Vertex f,Vertex t,EWeight w) noexcept : from(f),to(t),weight(w) {}
-    };
+    // 方向策略：无向图每条边在两端各存一份，有向图每条边只存在起点
+    struct Undirected { static constexpr bool directed=false; };
+    struct Directed { static constexpr bool directed=true; };
 
-    struct VertexNode
+    template <typename W=EWeight,typename Dir=Undirected>
+    class BasicLGraph
     {
-        std::list <Edge> adj;
-        LocationInfo info;
-        explicit VertexNode(const LocationInfo& i) : adj(),info(i) {}
-    };
+        public:
+            using Weight=W;
+            using Direction=Dir;
+            using EdgeType=BasicEdge<W>;
 
-    class LGraph
-    {
         private:
+            struct PendingOp        // 批量修改中暂存的一条操作
+            {
+                enum Kind : uint8_t { AddEdge,RemoveEdge,SetWeight,AddVertex,RemoveVertex };
+                Kind kind;
+                std::string u,v;    // AddVertex 时为名称与类型，RemoveVertex 只用 u
+                W weight{};
+                int visitTime=0;    // 只用于 AddVertex
+            };
+
+            struct ColdData         // 冷数据：名称与类型表，图的副本之间写时复制共享
+            {
+                std::vector <std::string> names;        // 顶点名称
+                std::vector <std::string> typeNames;    // 类型编号到类型名
+                std::map <std::string,TypeId> type_map; // 类型名到类型编号
+                std::map <std::string,Vertex> ver_map;
+            };
+
             size_t vertNum=0;      // 顶点数
             size_t edgeNum=0;      // 边数（无向图中每条边只记一次）
-            std::vector <VertexNode> ver_list;
-            std::map <std::string,Vertex> ver_map;
+            // 顶点按列存放：遍历只需访问热数据，名称等字符串放在冷数据中
+            std::vector <AdjBlock> adj;             // 热：邻接边在 arena 中的位置
+            std::vector <TypeId> typeOf;            // 热：类型编号
+            std::vector <int> visitTime;            // 热：建议游览时间
+            std::shared_ptr<ColdData> cold=std::make_shared<ColdData>();
+            EdgeArena<W> arena;    // 所有顶点的邻接边存放处，slab 在副本之间写时复制共享
+            uint64_t revision=0;   // 修改版本号
+            bool batching=false;
+            std::vector <PendingOp> pending;
+
+            TypeId InternType(const std::string& type);     // 取得类型编号，新类型时登记
+            ColdData& MutableCold();                        // 取得可写的冷数据，被其他副本共享时先复制一份
+            void RemoveVertices(const std::vector<char>& dead);     // 一次性删除多个顶点并重新编号
+            bool SetWeight(Vertex u,Vertex v,W weight);     // 改写边 u-v 的所有存储项（无向自环存了两份），边不存在时返回 false
 
         public:
-            LGraph()=default;
-            ~LGraph()=default;
+            // 复制很便宜：邻接 slab 与冷数据都是共享的，之后哪一份被修改就只复制它改到的部分
+            BasicLGraph()=default;
+            ~BasicLGraph()=default;
 
             size_t VertexCount() const noexcept { return vertNum; }     // 顶点数量
             size_t EdgesCount() const noexcept { return edgeNum; }      // 边数量（单向）
 
             bool ExistVertex(const std::string& name) const;                    // 是否存在顶点
-            bool ExistEdge(const std::string& u,const std::string& v) const;    // 是否存在边
+            bool ExistEdge(const std::string& u,const std::string& v) const;    // 是否存在边（有向图中为 u -> v）
 
             void InsertVertex(const LocationInfo& vertexInfo);                              // 插入顶点
             void DeleteVertex(const std::string& name);                                     // 删除顶点（通过名称）
             void UpdateVertex(const std::string& oldName,const LocationInfo& newInfo);      // 更新顶点信息（名称不变）
-            LocationInfo GetVertex(const std::string& name) const;                          // 通过名称查询顶点信息
-            LocationInfo GetVertex(Vertex vertex) const;                                    // 通过顶点 ID 查询顶点信息
+            LocationView GetVertex(const std::string& name) const;                          // 通过名称查询顶点信息
+            LocationView GetVertex(Vertex vertex) const;                                    // 通过顶点 ID 查询顶点信息
 
-            void InsertEdge(const std::string& u,const std::string& v,EWeight weight);      // 插入边（无向）
+            void InsertEdge(const std::string& u,const std::string& v,W weight);            // 插入边（无向图两端各存一份）
             void DeleteEdge(const std::string& u,const std::string& v);                     // 通过名称删除边
             void DeleteEdge(Vertex u,Vertex v);                                             // 通过顶点 ID 删除边
-            void UpdateEdge(const std::string& u,const std::string& v,EWeight newWeight);   // 更新边权
-            EWeight GetEdge(const std::string& u,const std::string& v) const;               // 查询边权
+            void UpdateEdge(const std::string& u,const std::string& v,W newWeight);         // 更新边权
+            W GetEdge(const std::string& u,const std::string& v) const;                     // 查询边权
 
-            const std::vector<VertexNode>& List() const noexcept { return ver_list; }        // 返回邻接表（非const）
-            std::vector<VertexNode>& List() noexcept { return ver_list; }                    // 返回邻接表（const）
-            const std::map<std::string,Vertex>& Map() const noexcept { return ver_map; }     // 返回名称到 ID 的映射（非const）
-            std::map<std::string,Vertex>& Map() noexcept { return ver_map; }                 // 返回名称到 ID 的映射（const）
+            AdjRange<W> Adj(Vertex vertex) const noexcept { return arena.View(vertex,adj[vertex]); }      // 顶点的邻接边（有向图中为出边）
+            size_t Degree(Vertex vertex) const noexcept { return adj[vertex].size; }                     // 顶点的度（有向图中为出度）
+            size_t AdjBytes() const noexcept { return arena.ReservedBytes(); }                           // 邻接存储占用的字节数
+            size_t SharedSlabs() const noexcept { return arena.SharedSlabs(); }                          // 与其他副本共享的邻接 slab 数
 
-            // 返回按权重排序后的所有无向边（只保留 u < v 的那一半）
-            std::vector<Edge> SortedEdges(std::function<bool(const EWeight&,const EWeight&)> cmp=std::less<>()) const;
+            const std::string& Name(Vertex vertex) const noexcept { return cold->names[vertex]; }              // 顶点名称
+            TypeId Type(Vertex vertex) const noexcept { return typeOf[vertex]; }                         // 顶点类型编号
+            int VisitTime(Vertex vertex) const noexcept { return visitTime[vertex]; }                    // 顶点游览时间
+            const std::string& TypeName(TypeId type) const noexcept { return cold->typeNames[type]; }          // 类型编号对应的类型名
+            std::optional<TypeId> FindType(const std::string& type) const;                               // 查询类型编号，未出现过的类型返回空
+
+            const std::map<std::string,Vertex>& Map() const noexcept { return cold->ver_map; }     // 返回名称到 ID 的映射（只读）
+
+            // 批量修改：BeginBatch 之后的 InsertVertex/DeleteVertex/InsertEdge/DeleteEdge/UpdateEdge 只做暂存，查询仍看到批量开始前的图；
+            // Commit 时按顺序校验全部操作，任何一条非法则整批不生效并抛出异常，否则新顶点追加在末尾，边按排序一次应用，顶点删除只重新编号一次
+            void BeginBatch();
+            void Commit();
+            void Rollback() noexcept { pending.clear(); batching=false; }     // 丢弃暂存的修改
+            bool InBatch() const noexcept { return batching; }
+            uint64_t Revision() const noexcept { return revision; }   // 每次生效的修改（一次 Commit 算一次）加一，供派生索引判断是否过期
+
+            // 返回按权重排序后的所有边（无向图只保留 u < v 的那一半）
+            std::vector<EdgeType> SortedEdges(std::function<bool(const W&,const W&)> cmp=std::less<>()) const;
         };
+
+    using LGraph=BasicLGraph<EWeight,Undirected>;   // 默认的校园无向图
+    using DiGraph=BasicLGraph<EWeight,Directed>;    // 含单行道的有向图
 }
 
-#endif // LGRAPH_LGRAPH_H
\ No newline at end of file
+// 显式实例化的边权类型与方向组合
+#define GRAPH_FOR_EACH_INSTANCE(X) \
+    X(std::int16_t,Graph::Undirected) X(std::int32_t,Graph::Undirected) X(std::int64_t,Graph::Undirected) X(float,Graph::Undirected) \
+    X(std::int16_t,Graph::Directed) X(std::int32_t,Graph::Directed) X(std::int64_t,Graph::Directed) X(float,Graph::Directed)
+
+#endif // LGRAPH_LGRAPH_H
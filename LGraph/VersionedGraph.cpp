@@ -0,0 +1,67 @@
+#include <thread>
+#include <algorithm>
+#include "VersionedGraph.h"
+
+namespace Graph
+{
+    template <typename W,typename Dir>
+    VersionedGraph<W,Dir>::VersionedGraph(GraphType initial) :
+        current(new Node{std::make_shared<const GraphType>(std::move(initial))})
+    {
+    }
+
+    template <typename W,typename Dir>
+    VersionedGraph<W,Dir>::~VersionedGraph()
+    {
+        for (Node* n : retired){
+            delete n;
+        }
+        delete current.load();
+    }
+
+    template <typename W,typename Dir>
+    typename VersionedGraph<W,Dir>::Version VersionedGraph<W,Dir>::Pin() const
+    {
+        size_t i=std::hash<std::thread::id>()(std::this_thread::get_id())%HazardSlots;    // 不同线程尽量从不同空位开始找
+        for (;;i=(i+1)%HazardSlots){
+            Node* p=current.load();
+            Node* expected=nullptr;
+            if (!hazard[i].compare_exchange_strong(expected,p)){
+                continue;
+            }
+            // 登记之后再确认 p 仍是当前版本：写者替换版本后才扫描危险指针，
+            // 所以确认成功时写者要么还没替换，要么一定能看到这次登记，p 不会被释放
+            for (Node* now;(now=current.load())!=p;){
+                p=now;
+                hazard[i].store(p);
+            }
+            Version version=p->graph;
+            hazard[i].store(nullptr);
+            return version;
+        }
+    }
+
+    template <typename W,typename Dir>
+    void VersionedGraph<W,Dir>::Publish(Version next)
+    {
+        retired.push_back(current.exchange(new Node{std::move(next)}));
+        std::vector <Node*> busy;
+        for (const std::atomic<Node*>& h : hazard){
+            if (Node* p=h.load()){
+                busy.push_back(p);
+            }
+        }
+        // 节点只持有版本的一份引用，读者已经复制走的引用不受释放节点影响
+        std::erase_if(retired,[&](Node* n){
+            if (std::find(busy.begin(),busy.end(),n)!=busy.end()){
+                return false;
+            }
+            delete n;
+            return true;
+        });
+    }
+
+    #define INSTANTIATE_VERSIONED_GRAPH(W,Dir) template class VersionedGraph<W,Dir>;
+    GRAPH_FOR_EACH_INSTANCE(INSTANTIATE_VERSIONED_GRAPH)
+    #undef INSTANTIATE_VERSIONED_GRAPH
+}
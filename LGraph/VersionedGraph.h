@@ -0,0 +1,67 @@
+#ifndef LGRAPH_VERSIONEDGRAPH_H
+#define LGRAPH_VERSIONEDGRAPH_H
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <string>
+#include "LGraph.h"
+
+namespace Graph
+{
+    // 多版本图：写者在当前版本的副本上修改，完成后整体发布为新版本；副本与旧版本共享未改动的邻接 slab 和冷数据。
+    // 读者用 Pin 取得某个版本后可在其上运行任意只读算法，不受之后的修改影响；版本在最后一个持有者释放时回收。
+    // Pin 不加锁：当前版本挂在原子指针上，读者先用危险指针（hazard pointer）登记再复制引用，写者不会回收已登记的节点
+    template <typename W=EWeight,typename Dir=Undirected>
+    class VersionedGraph
+    {
+        public:
+            using GraphType=BasicLGraph<W,Dir>;
+            using Version=std::shared_ptr<const GraphType>;
+            static constexpr size_t HazardSlots=128;    // 可同时处于 Pin 中的线程数，全部占满时后来者轮询等待空位
+
+        private:
+            struct Node             // 一个已发布的版本
+            {
+                Version graph;
+            };
+
+            std::atomic<Node*> current;
+            mutable std::array<std::atomic<Node*>,HazardSlots> hazard{};   // 读者正在复制引用的节点，空位为 nullptr
+            std::vector <Node*> retired;    // 已被替换、等待无人访问后释放的节点，只由写者访问
+            std::mutex writer;              // 写者之间互斥，读者不使用
+
+            void Publish(Version next);     // 发布新版本并释放没有读者访问的旧节点，调用时需持有 writer
+
+        public:
+            VersionedGraph() : VersionedGraph(GraphType()) {}
+            explicit VersionedGraph(GraphType initial);
+            ~VersionedGraph();      // 析构时不能再有读者在 Pin 中（已 Pin 到的版本仍然有效）
+            VersionedGraph(const VersionedGraph&)=delete;
+            VersionedGraph& operator=(const VersionedGraph&)=delete;
+
+            Version Pin() const;    // 取得当前版本，持有期间该版本不会改变也不会被回收
+            uint64_t Revision() const { return Pin()->Revision(); }
+
+            // 在当前版本的副本上执行 fn(GraphType&) 后发布；fn 抛出异常时不发布，当前版本保持不变
+            template <typename F>
+            void Update(F&& fn)
+            {
+                std::lock_guard<std::mutex> lock(writer);
+                auto next=std::make_shared<GraphType>(*current.load()->graph);
+                fn(*next);
+                Publish(std::move(next));
+            }
+
+            // 常用的单条修改，每次调用发布一个新版本；多条修改应放进一次 Update 中
+            void InsertVertex(const LocationInfo& vertexInfo) { Update([&](GraphType& g){ g.InsertVertex(vertexInfo); }); }
+            void DeleteVertex(const std::string& name) { Update([&](GraphType& g){ g.DeleteVertex(name); }); }
+            void InsertEdge(const std::string& u,const std::string& v,W weight) { Update([&](GraphType& g){ g.InsertEdge(u,v,weight); }); }
+            void DeleteEdge(const std::string& u,const std::string& v) { Update([&](GraphType& g){ g.DeleteEdge(u,v); }); }
+            void UpdateEdge(const std::string& u,const std::string& v,W newWeight) { Update([&](GraphType& g){ g.UpdateEdge(u,v,newWeight); }); }
+    };
+}
+
+#endif // LGRAPH_VERSIONEDGRAPH_H
@@ -12,6 +12,15 @@ namespace Graph
         LocationInfo()=default;
         LocationInfo(const std::string& n,const std::string& t,int v) noexcept : name(n),type(t),visitTime(v) {}
     };
+
+    // 顶点信息的只读视图，字段引用图内部存储，图被修改后失效
+    struct LocationView
+    {
+        const std::string& name;
+        const std::string& type;
+        int visitTime=0;
+        operator LocationInfo() const { return LocationInfo(name,type,visitTime); }
+    };
 }
 
 #endif // CAMPUSNAVIGATION_LOCATIONINFO_H
\ No newline at end of file
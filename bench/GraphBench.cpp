@@ -0,0 +1,124 @@
+#include <list>
+#include <chrono>
+#include <random>
+#include <string>
+#include <cstdlib>
+#include <algorithm>
+#include <iostream>
+#include "LGraph/LGraph.h"
+#include "Algorithm/Algorithm.h"
+
+using namespace Graph;
+using namespace Graph::Algorithm;
+
+// 性能基准：可选参数为规模倍数（默认 1），顶点数与操作数按倍数放大
+namespace
+{
+    using Clock=std::chrono::steady_clock;
+
+    double Millis(Clock::time_point begin,Clock::time_point end)
+    {
+        return std::chrono::duration<double,std::milli>(end-begin).count();
+    }
+
+    std::string Name(size_t i)
+    {
+        return "v"+std::to_string(i);
+    }
+
+    // 邻接存储：先大量随机增删改边，再做最短路查询
+    void MutateThenQuery(size_t scale)
+    {
+        const size_t n=3000*scale,mutations=300000*scale,queries=300;
+        std::mt19937 rng(26);
+        LGraph graph;
+        for (size_t i=0;i<n;i++){
+            graph.InsertVertex(LocationInfo(Name(i),"t",1));
+        }
+        auto t0=Clock::now();
+        for (size_t i=0;i<mutations;i++){
+            std::string u=Name(rng()%n),v=Name(rng()%n);
+            if (u==v){
+                continue;
+            }
+            switch (rng()%3){
+                case 0:
+                    graph.InsertEdge(u,v,rng()%100+1);
+                    break;
+                case 1:
+                    if (graph.ExistEdge(u,v)){
+                        graph.DeleteEdge(u,v);
+                    }
+                    break;
+                default:
+                    if (graph.ExistEdge(u,v)){
+                        graph.UpdateEdge(u,v,rng()%100+1);
+                    }
+            }
+        }
+        auto t1=Clock::now();
+        PathWeight<EWeight> checksum=0;
+        for (size_t i=0;i<queries;i++){
+            checksum+=GetShortestPath(graph,Name(rng()%n),Name(rng()%n));
+        }
+        auto t2=Clock::now();
+        std::cout<<"[mutate-then-query] "<<n<<" 顶点, "<<mutations<<" 次增删改边后剩 "<<graph.EdgesCount()<<" 条边\n"
+                 <<"  修改 "<<Millis(t0,t1)<<" ms, "<<queries<<" 次 GetShortestPath "<<Millis(t1,t2)<<" ms (校验和 "<<checksum<<")\n"
+                 <<"  邻接存储 "<<graph.AdjBytes()<<" 字节"<<std::endl;
+    }
+
+    // 顶点存储布局：每顶点字节数，以及只读热数据的整图遍历耗时
+    void VertexLayout(size_t scale)
+    {
+        struct ListVertexNode   // 9dca4df 的顶点结构：邻接边用 std::list 存放
+        {
+            std::list <Edge> adj;
+            LocationInfo info;
+        };
+        struct ArenaVertexNode  // 18bc0be 邻接边移入 EdgeArena 后、按列存放前的顶点结构
+        {
+            AdjBlock adj;
+            LocationInfo info;
+        };
+        std::cout<<"[vertex-layout] 每顶点字节数: 9dca4df VertexNode "<<sizeof(ListVertexNode)
+                 <<", 18bc0be VertexNode "<<sizeof(ArenaVertexNode)
+                 <<", 现在热数据 "<<sizeof(AdjBlock)+sizeof(TypeId)+sizeof(int)
+                 <<" + 冷数据（名称） "<<sizeof(std::string)<<std::endl;
+
+        const size_t n=200000*scale,m=400000*scale;
+        std::mt19937 rng(27);
+        LGraph graph;
+        for (size_t i=0;i<n;i++){
+            graph.InsertVertex(LocationInfo(Name(i),"type"+std::to_string(rng()%8),1));
+        }
+        for (size_t i=1;i<n;i++){       // 先连成一棵树保证连通，再补随机边
+            graph.InsertEdge(Name(i),Name(rng()%i),rng()%100+1);
+        }
+        while (graph.EdgesCount()<m){
+            std::string u=Name(rng()%n),v=Name(rng()%n);
+            if (u!=v){
+                graph.InsertEdge(u,v,rng()%100+1);
+            }
+        }
+        auto t0=Clock::now();
+        size_t connected=0;
+        for (int i=0;i<20;i++){
+            connected+=IsConnected(graph);
+        }
+        PathWeight<EWeight> checksum=0;
+        for (int i=0;i<10;i++){
+            checksum+=GetShortestPath(graph,Name(rng()%n),Name(rng()%n));
+        }
+        auto t1=Clock::now();
+        std::cout<<"  "<<n<<" 顶点, "<<graph.EdgesCount()<<" 条边: 20 次 IsConnected + 10 次 GetShortestPath "
+                 <<Millis(t0,t1)<<" ms (校验和 "<<connected<<"/"<<checksum<<")"<<std::endl;
+    }
+}
+
+int main(int argc,char* argv[])
+{
+    size_t scale=argc>1 ? std::max(1L,std::atol(argv[1])) : 1;
+    MutateThenQuery(scale);
+    VertexLayout(scale);
+    return 0;
+}
@@ -7,6 +7,7 @@
 #include <algorithm>
 #include "LGraph/LGraph.h"
 #include "Algorithm/Algorithm.h"
+#include "Algorithm/FacilityIndex.h"
 #include "LocationInfo.h"
 #include "GraphException.h"
 
@@ -31,6 +32,7 @@ int main()
         std::cerr<<"初始化失败: "<<e.what()<<std::endl;
         return -1;
     }
+    FacilityIndex<EWeight,Undirected> facilities(graph);    // NEAREST_TYPE 用的最近设施划分
 
     std::ifstream cmdIn(command_path);
     std::ofstream ansOut(answer_path);
@@ -62,6 +64,22 @@ int main()
                 ansOut<<std::endl;
             }
         }
+        else if (cmd=="ALT_PATHS"){
+            std::string u,v;
+            size_t k=1;
+            iss>>u>>v>>k;
+            auto routes=KShortestPaths(graph,u,v,k);
+            if (routes.empty()){
+                ansOut<<"NA"<<std::endl;
+            }
+            for (auto& [dist,path] : routes){      // 每条备选路线占一行，按长度升序
+                ansOut<<"DIST "<<dist<<" PATH";
+                for (std::string& name : path){
+                    ansOut<<" "<<name;
+                }
+                ansOut<<std::endl;
+            }
+        }
         else if (cmd=="ADJ_EDGES"){
             std::string u;
             iss>>u;
@@ -69,15 +87,15 @@ int main()
                 ansOut<<"NONE"<<std::endl;
                 continue;
             }
-            Vertex uid=graph.Map()[u];
-            const std::list <Edge>& adj=graph.List()[uid].adj;
+            Vertex uid=graph.Map().at(u);
+            AdjRange<EWeight> adj=graph.Adj(uid);
             if (adj.empty()){
                 ansOut<<"NONE"<<std::endl;
                 continue;
             }
             std::vector <std::pair<std::string,int>> res;
             for (const Edge& e : adj) {
-                res.emplace_back(graph.GetVertex(e.to).name,e.weight);
+                res.emplace_back(graph.Name(e.to),e.weight);
             }
             std::sort(res.begin(),res.end(),[](auto& a,auto& b){ return a.first<b.first; });
             bool first=true;
@@ -93,15 +111,43 @@ int main()
         else if (cmd=="FIND_TYPE"){
             std::string type;
             iss>>type;
+            std::optional<TypeId> tid=graph.FindType(type);
             bool first=true;
-            for (VertexNode& vnode : graph.List()){
-                if (vnode.info.type==type){
+            for (Vertex u=0;tid&&u<graph.VertexCount();u++){
+                if (graph.Type(u)==*tid){
                     if (!first){
                         ansOut<<" ";
                     }
                     first=false;
-                    ansOut<<vnode.info.name;
+                    ansOut<<graph.Name(u);
+                }
+            }
+            ansOut<<std::endl;
+        }
+        else if (cmd=="NEAREST_TYPE"){
+            std::string u,type;
+            size_t k;
+            iss>>u>>type;
+            if (!(iss>>k)){     // k 可省略
+                k=1;
+            }
+            std::optional<TypeId> tid=graph.FindType(type);
+            if (!graph.ExistVertex(u)||!tid){
+                ansOut<<"NONE"<<std::endl;
+                continue;
+            }
+            auto nearest=facilities.KNearest(graph.Map().at(u),*tid,k);
+            if (nearest.empty()){
+                ansOut<<"NONE"<<std::endl;
+                continue;
+            }
+            bool first=true;
+            for (auto& [site,dist] : nearest){
+                if (!first){
+                    ansOut<<" ";
                 }
+                first=false;
+                ansOut<<graph.Name(site)<<"("<<dist<<")";
             }
             ansOut<<std::endl;
         }
@@ -110,33 +156,81 @@ int main()
             int w;
             iss>>u>>v>>w;
             graph.InsertEdge(u,v,w);
-            ansOut<<"OK"<<std::endl;
+            if (!graph.InBatch()){      // 批量中的修改在 END 时统一输出结果
+                facilities.EdgeChanged(graph.Map().at(u),graph.Map().at(v));
+                ansOut<<"OK"<<std::endl;
+            }
         }
         else if (cmd=="DELETE_EDGE"){
             std::string u,v;
             iss>>u>>v;
             graph.DeleteEdge(u,v);
-            ansOut<<"OK"<<std::endl;
+            if (!graph.InBatch()){      // 批量中的修改在 END 时统一输出结果
+                facilities.EdgeChanged(graph.Map().at(u),graph.Map().at(v));
+                ansOut<<"OK"<<std::endl;
+            }
         }
         else if (cmd=="MODIFY_EDGE_WEIGHT"){
             std::string u,v;
             int w;
             iss>>u>>v>>w;
             graph.UpdateEdge(u,v,w);
-            ansOut<<"OK"<<std::endl;
+            if (!graph.InBatch()){      // 批量中的修改在 END 时统一输出结果
+                facilities.EdgeChanged(graph.Map().at(u),graph.Map().at(v));
+                ansOut<<"OK"<<std::endl;
+            }
         }
         else if (cmd=="INSERT_NODE"){
             std::string name,type;
             int vt;
             iss>>name>>type>>vt;
             graph.InsertVertex(LocationInfo(name,type,vt));
-            ansOut<<"OK"<<std::endl;
+            if (!graph.InBatch()){
+                ansOut<<"OK"<<std::endl;
+            }
         }
         else if (cmd=="DELETE_NODE"){
             std::string name;
             iss>>name;
             graph.DeleteVertex(name);
-            ansOut<<"OK"<<std::endl;
+            if (!graph.InBatch()){      // 批量中的修改在 END 时统一输出结果
+                ansOut<<"OK"<<std::endl;
+            }
+        }
+        else if (cmd=="BATCH"){
+            try {
+                graph.BeginBatch();
+            }
+            catch (const GraphException& e){    // 已在批量中：报错，原批量保持打开
+                ansOut<<"ERROR "<<e.what()<<std::endl;
+            }
+        }
+        else if (cmd=="END"){
+            try {
+                graph.Commit();
+                ansOut<<"OK"<<std::endl;
+            }
+            catch (const GraphException& e){
+                ansOut<<"ERROR "<<e.what()<<std::endl;
+            }
+        }
+        else if (cmd=="PATROL_ROUTE"){
+            std::string u;
+            iss>>u;
+            if (!graph.ExistVertex(u)){
+                ansOut<<"NA"<<std::endl;
+                continue;
+            }
+            PatrolRoute<EWeight> patrol=ChinesePostmanRoute(graph,graph.Map().at(u));
+            if (patrol.length<0){
+                ansOut<<"NA"<<std::endl;
+                continue;
+            }
+            ansOut<<(patrol.optimal ? "DIST " : "APPROX DIST ")<<patrol.length<<" PATH";     // 奇度顶点过多时路线不保证最短
+            for (Vertex v : patrol.route){
+                ansOut<<" "<<graph.Name(v);
+            }
+            ansOut<<std::endl;
         }
         else if (cmd=="EULERIAN_PATH"){
             ansOut<<(ExistEulerPath(graph) ? "YES" : "NO")<<std::endl;
@@ -147,7 +241,7 @@ int main()
                 ansOut<<"DISCONNECTED"<<std::endl;
             }
             else {
-                int total=0;
+                PathWeight<EWeight> total=0;
                 std::vector <std::pair<std::string,std::string>> names;
                 for (Edge& e : edges){
                     total+=e.weight;
@@ -0,0 +1,115 @@
+#include <map>
+#include <tuple>
+#include <random>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <iostream>
+#include "LGraph/LGraph.h"
+
+using namespace Graph;
+
+// 批量修改与逐条执行同一串操作的结果必须完全一致：逐条执行中途出错时整批应被拒绝且图不变。
+// 操作含顶点增删与自环，比较每个顶点的类型、游览时间和完整邻接表（自环的两份存储项都要一致）
+namespace
+{
+    int failures=0;
+
+    template <typename W>
+    using Snapshot=std::map<std::string,std::tuple<std::string,int,std::vector<std::pair<std::string,W>>>>;   // 名称 -> <类型, 游览时间, 邻接表>
+
+    template <typename W,typename Dir>
+    Snapshot<W> Dump(const BasicLGraph<W,Dir>& graph)
+    {
+        Snapshot<W> res;
+        for (Vertex u=0;u<graph.VertexCount();u++){
+            std::vector <std::pair<std::string,W>> edges;
+            for (const BasicEdge<W>& e : graph.Adj(u)){
+                edges.emplace_back(graph.Name(e.to),e.weight);
+            }
+            std::sort(edges.begin(),edges.end());
+            res[graph.Name(u)]={graph.TypeName(graph.Type(u)),graph.VisitTime(u),edges};
+        }
+        return res;
+    }
+
+    template <typename W,typename Dir>
+    void Check(std::mt19937& rng,int rounds)
+    {
+        const int names=12;
+        BasicLGraph<W,Dir> graph;
+        for (int i=0;i<8;i++){
+            graph.InsertVertex(LocationInfo("v"+std::to_string(i),"t",1));
+        }
+        for (int round=0;round<rounds;round++){
+            BasicLGraph<W,Dir> expect=graph;
+            bool valid=true;
+            graph.BeginBatch();
+            int ops=rng()%5+1;
+            for (int i=0;i<ops;i++){
+                std::string a="v"+std::to_string(rng()%names);
+                std::string b=rng()%4 ? "v"+std::to_string(rng()%names) : a;     // 四分之一是自环
+                int raw=rng()%9+1;
+                W weight=static_cast<W>(raw);
+                std::string type="t"+std::to_string(rng()%3);
+                int kind=rng()%10;
+                auto Apply=[&](BasicLGraph<W,Dir>& g){
+                    if (kind<3){
+                        g.InsertEdge(a,b,weight);
+                    }
+                    else if (kind<5){
+                        g.DeleteEdge(a,b);
+                    }
+                    else if (kind<8){
+                        g.UpdateEdge(a,b,weight);
+                    }
+                    else if (kind==8){
+                        g.DeleteVertex(a);
+                    }
+                    else {
+                        g.InsertVertex(LocationInfo(a,type,raw));
+                    }
+                };
+                Apply(graph);       // 批量中只暂存
+                if (valid){
+                    try {
+                        Apply(expect);
+                    }
+                    catch (const GraphException&){
+                        valid=false;
+                    }
+                }
+            }
+            Snapshot<W> before=Dump(graph);
+            size_t edgesBefore=graph.EdgesCount();
+            bool committed=true;
+            try {
+                graph.Commit();
+            }
+            catch (const GraphException&){
+                committed=false;
+            }
+            bool ok=committed==valid&&Dump(graph)==(valid ? Dump(expect) : before)
+                    &&graph.EdgesCount()==(valid ? expect.EdgesCount() : edgesBefore);
+            if (!ok){
+                std::cerr<<"批量结果与逐条执行不一致: round "<<round<<", directed "<<Dir::directed<<", sizeof(W) "<<sizeof(W)<<std::endl;
+                failures++;
+                return;
+            }
+        }
+    }
+}
+
+int main()
+{
+    std::mt19937 rng(31);
+    #define CHECK_INSTANCE(W,Dir) Check<W,Dir>(rng,3000);
+    GRAPH_FOR_EACH_INSTANCE(CHECK_INSTANCE)
+    #undef CHECK_INSTANCE
+    if (failures){
+        std::cerr<<failures<<" 项检查失败"<<std::endl;
+        return 1;
+    }
+    std::cout<<"批量修改与逐条执行一致"<<std::endl;
+    return 0;
+}
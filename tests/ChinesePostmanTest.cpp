@@ -0,0 +1,124 @@
+#include <set>
+#include <random>
+#include <string>
+#include <vector>
+#include <iostream>
+#include "LGraph/LGraph.h"
+#include "Algorithm/Algorithm.h"
+
+using namespace Graph;
+using namespace Graph::Algorithm;
+
+// ChinesePostmanRoute 在随机小图（含自环）上的长度必须等于暴力求出的最优值：Floyd 求奇度顶点间距离，
+// 再对奇度顶点集合做状态压缩 DP 求最小权完美匹配。同时检查路线首尾为起点、相邻顶点有边、覆盖所有边且长度与边权之和一致
+namespace
+{
+    int failures=0;
+
+    template <typename W>
+    void Check(std::mt19937& rng,int rounds)
+    {
+        using D=PathWeight<W>;
+        const D INF=PathTree<W>::Unreachable;
+        for (int round=0;round<rounds;round++){
+            BasicLGraph<W,Undirected> graph;
+            size_t n=rng()%28+2;
+            for (size_t i=0;i<n;i++){
+                graph.InsertVertex(LocationInfo("v"+std::to_string(i),"t",1));
+            }
+            for (size_t i=1;i<n;i++){       // 先连成一棵树保证连通
+                graph.InsertEdge("v"+std::to_string(i),"v"+std::to_string(rng()%i),static_cast<W>(rng()%20+1));
+            }
+            size_t m=rng()%(n+1);
+            for (size_t i=0;i<m;i++){
+                size_t u=rng()%n,v=rng()%5 ? rng()%n : u;
+                graph.InsertEdge("v"+std::to_string(u),"v"+std::to_string(v),static_cast<W>(rng()%20+1));
+            }
+            std::vector <size_t> odd;
+            for (Vertex u=0;u<n;u++){
+                if (graph.Degree(u)%2){
+                    odd.push_back(u);
+                }
+            }
+            if (odd.size()>16){
+                continue;
+            }
+
+            std::vector <std::vector<D>> dist(n,std::vector<D>(n,INF));
+            D total=0;
+            for (Vertex u=0;u<n;u++){
+                for (const BasicEdge<W>& e : graph.Adj(u)){
+                    dist[u][e.to]=std::min<D>(dist[u][e.to],e.weight);
+                    if (u<=e.to){
+                        total+=e.weight;
+                    }
+                }
+                dist[u][u]=0;
+            }
+            for (Vertex u=0;u<n;u++){       // 自环在邻接表中出现两次
+                if (graph.ExistEdge("v"+std::to_string(u),"v"+std::to_string(u))){
+                    total-=graph.GetEdge("v"+std::to_string(u),"v"+std::to_string(u));
+                }
+            }
+            for (size_t k=0;k<n;k++){
+                for (size_t i=0;i<n;i++){
+                    for (size_t j=0;j<n;j++){
+                        if (dist[i][k]!=INF&&dist[k][j]!=INF){
+                            dist[i][j]=std::min(dist[i][j],dist[i][k]+dist[k][j]);
+                        }
+                    }
+                }
+            }
+            size_t t=odd.size();
+            std::vector <D> best(size_t(1)<<t,INF);
+            best[0]=0;
+            for (size_t mask=1;mask<best.size();mask++){
+                size_t i=0;
+                while (!(mask>>i&1)){
+                    i++;
+                }
+                for (size_t j=i+1;j<t;j++){
+                    size_t rest=mask^(size_t(1)<<i)^(size_t(1)<<j);
+                    if (mask>>j&1&&best[rest]!=INF){
+                        best[mask]=std::min(best[mask],best[rest]+dist[odd[i]][odd[j]]);
+                    }
+                }
+            }
+            D expect=total+best.back();
+
+            Vertex start=rng()%n;
+            PatrolRoute<W> got=ChinesePostmanRoute(graph,start);
+            bool ok=got.optimal&&got.length==expect&&got.route.size()>=1&&got.route.front()==start&&got.route.back()==start;
+            D walked=0;
+            std::set <std::pair<Vertex,Vertex>> covered;
+            for (size_t i=0;ok&&i+1<got.route.size();i++){
+                Vertex u=got.route[i],v=got.route[i+1];
+                ok=graph.ExistEdge(graph.Name(u),graph.Name(v));
+                if (ok){
+                    walked+=graph.GetEdge(graph.Name(u),graph.Name(v));
+                    covered.insert({std::min(u,v),std::max(u,v)});
+                }
+            }
+            ok&=walked==got.length&&covered.size()==graph.EdgesCount();
+            if (!ok){
+                std::cerr<<"巡逻路线错误: round "<<round<<", n "<<n<<", 奇度顶点 "<<t<<", sizeof(W) "<<sizeof(W)
+                         <<", 长度 "<<got.length<<", 最优 "<<expect<<std::endl;
+                failures++;
+            }
+        }
+    }
+}
+
+int main()
+{
+    std::mt19937 rng(33);
+    #define CHECK_WEIGHT(W) Check<W>(rng,300);
+    GRAPH_FOR_EACH_WEIGHT(CHECK_WEIGHT)
+    #undef CHECK_WEIGHT
+    if (failures){
+        std::cerr<<failures<<" 项检查失败"<<std::endl;
+        return 1;
+    }
+    std::cout<<"ChinesePostmanRoute 与暴力最优解一致"<<std::endl;
+    return 0;
+}
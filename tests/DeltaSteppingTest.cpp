@@ -0,0 +1,74 @@
+#include <random>
+#include <string>
+#include <iostream>
+#include "LGraph/LGraph.h"
+#include "Algorithm/Algorithm.h"
+
+using namespace Graph;
+using namespace Graph::Algorithm;
+
+// DeltaSteppingTree 与 ShortestPathTree 在随机图上的距离必须完全一致（含零权边），
+// 覆盖所有实例化的边权类型、两种方向以及多组 delta/线程数
+namespace
+{
+    int failures=0;
+
+    template <typename W,typename Dir>
+    void Check(std::mt19937& rng,int rounds)
+    {
+        const PathWeight<W> deltas[]={0,1,3,1000};     // 0 为自动选取
+        const unsigned threads[]={1,2,4,8};
+        for (int round=0;round<rounds;round++){
+            BasicLGraph<W,Dir> graph;
+            size_t n=rng()%120+1;
+            for (size_t i=0;i<n;i++){
+                graph.InsertVertex(LocationInfo("v"+std::to_string(i),"t",1));
+            }
+            size_t m=rng()%(n*4+1);
+            int maxWeight=round%3 ? 20 : 2;     // 部分图边权很小，零权边更多
+            for (size_t i=0;i<m;i++){
+                size_t u=rng()%n,v=rng()%n;
+                if (u!=v){
+                    graph.InsertEdge("v"+std::to_string(u),"v"+std::to_string(v),static_cast<W>(rng()%(maxWeight+1)));
+                }
+            }
+            std::string source="v"+std::to_string(rng()%n);
+            PathTree<W> expect=ShortestPathTree(graph,source);
+            PathTree<W> got=DeltaSteppingTree(graph,source,deltas[round%4],threads[(round/4)%4]);
+            if (got.dist!=expect.dist){
+                std::cerr<<"距离不一致: round "<<round<<", n "<<n<<", directed "<<Dir::directed<<", sizeof(W) "<<sizeof(W)<<std::endl;
+                failures++;
+                continue;
+            }
+            for (Vertex v=0;v<n;v++){       // 前驱必须落在某条最短路径上
+                Vertex p=got.parent[v];
+                if (p==PathTree<W>::NoParent){
+                    continue;
+                }
+                bool tight=false;
+                for (const BasicEdge<W>& e : graph.Adj(p)){
+                    tight|=e.to==v&&got.dist[p]+e.weight==got.dist[v];
+                }
+                if (!tight){
+                    std::cerr<<"前驱不在最短路径上: round "<<round<<", 顶点 "<<v<<std::endl;
+                    failures++;
+                    break;
+                }
+            }
+        }
+    }
+}
+
+int main()
+{
+    std::mt19937 rng(29);
+    #define CHECK_INSTANCE(W,Dir) Check<W,Dir>(rng,200);
+    GRAPH_FOR_EACH_INSTANCE(CHECK_INSTANCE)
+    #undef CHECK_INSTANCE
+    if (failures){
+        std::cerr<<failures<<" 项检查失败"<<std::endl;
+        return 1;
+    }
+    std::cout<<"DeltaSteppingTree 与 ShortestPathTree 一致"<<std::endl;
+    return 0;
+}
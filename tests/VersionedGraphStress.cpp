@@ -0,0 +1,104 @@
+#include <atomic>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include <iostream>
+#include "LGraph/VersionedGraph.h"
+#include "Algorithm/Algorithm.h"
+
+using namespace Graph;
+using namespace Graph::Algorithm;
+
+// 多个读者线程不断 Pin 版本并在其上查询最短路，同时写者发布单条 UpdateEdge 和批量修改的新版本。
+// 每条路径的长度必须等于 Pin 到的版本中沿途各边 GetEdge 的权重之和，且版本在持有期间不变
+namespace
+{
+    const int Side=30;          // 网格边长
+    const int Readers=6;
+    const int Updates=3000;     // 写者发布的版本数（不含批量）
+
+    std::string Name(int r,int c)
+    {
+        return "v"+std::to_string(r*Side+c);
+    }
+
+    PathWeight<EWeight> PathCost(const LGraph& graph,const std::vector<std::string>& path)
+    {
+        PathWeight<EWeight> cost=0;
+        for (size_t i=0;i+1<path.size();i++){
+            cost+=graph.GetEdge(path[i],path[i+1]);
+        }
+        return cost;
+    }
+}
+
+int main()
+{
+    std::mt19937 rng(32);
+    LGraph initial;
+    for (int i=0;i<Side*Side;i++){
+        initial.InsertVertex(LocationInfo("v"+std::to_string(i),"t",1));
+    }
+    for (int r=0;r<Side;r++){
+        for (int c=0;c<Side;c++){
+            if (r+1<Side){
+                initial.InsertEdge(Name(r,c),Name(r+1,c),rng()%20+1);
+            }
+            if (c+1<Side){
+                initial.InsertEdge(Name(r,c),Name(r,c+1),rng()%20+1);
+            }
+        }
+    }
+    VersionedGraph<> graph(std::move(initial));
+
+    std::atomic<bool> stop=false;
+    std::atomic<long> queries=0,failures=0;
+    std::vector <std::thread> readers;
+    for (int t=0;t<Readers;t++){
+        readers.emplace_back([&,t]{
+            std::mt19937 local(100+t);
+            while (!stop||queries<Readers*100){
+                VersionedGraph<>::Version version=graph.Pin();
+                uint64_t revision=version->Revision();
+                std::string a="v"+std::to_string(local()%(Side*Side)),b="v"+std::to_string(local()%(Side*Side));
+                auto [dist,path]=ShortestPathwithTrace(*version,a,b);
+                bool ok=!path.empty()&&path.front()==a&&path.back()==b&&PathCost(*version,path)==dist;
+                std::this_thread::yield();      // 让写者在两次查询之间发布新版本
+                auto [again,path2]=ShortestPathwithTrace(*version,a,b);
+                ok&=again==dist&&PathCost(*version,path)==dist&&version->Revision()==revision;
+                if (!ok){
+                    std::cerr<<"版本 "<<revision<<" 上 "<<a<<" -> "<<b<<" 的路径长度与边权不一致"<<std::endl;
+                    failures++;
+                }
+                queries++;
+            }
+        });
+    }
+
+    for (int i=0;i<Updates;i++){
+        int r=rng()%Side,c=rng()%(Side-1);
+        graph.UpdateEdge(Name(r,c),Name(r,c+1),rng()%20+1);
+        if (i%200==0){      // 批量修改整体作为一个版本发布
+            graph.Update([&](LGraph& g){
+                g.BeginBatch();
+                for (int k=0;k<20;k++){
+                    int rr=rng()%(Side-1),cc=rng()%Side;
+                    g.UpdateEdge(Name(rr,cc),Name(rr+1,cc),rng()%20+1);
+                }
+                g.Commit();
+            });
+        }
+    }
+    stop=true;
+    for (std::thread& t : readers){
+        t.join();
+    }
+
+    if (failures){
+        std::cerr<<failures<<" / "<<queries<<" 次查询失败"<<std::endl;
+        return 1;
+    }
+    std::cout<<queries<<" 次查询与所 Pin 版本的边权一致，当前版本 "<<graph.Revision()<<std::endl;
+    return 0;
+}